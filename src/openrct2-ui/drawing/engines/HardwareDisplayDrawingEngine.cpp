@@ -14,13 +14,18 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <openrct2/common.h>
 #include <SDL2/SDL.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
 #include <openrct2/drawing/IDrawingEngine.h>
+#include <openrct2/drawing/Rain.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/Intro.h>
 #include <openrct2/ui/UiContext.h>
 #include "DrawingEngines.h"
 
@@ -56,6 +61,38 @@ private:
     bool    _useVsync               = true;
 
     std::vector<uint32> _dirtyVisualsTime;
+
+    // Only the blocks of the screen that changed since the last frame are converted and uploaded.
+    // Blocks are marked when they are redrawn through the dirty grid or invalidated, which covers the
+    // overlays drawn directly to the screen (chat, console, picked up peep, FPS). Rain and viewports
+    // that scrolled are marked separately, as they are drawn without invalidating.
+    std::vector<uint8>  _textureDirtyBlocks;
+    std::vector<uint32> _textureBits;
+    bool                _textureInvalidated = true;
+    std::vector<SDL_Rect> _rainRects;
+    rct_viewport        _textureViewports[MAX_VIEWPORT_COUNT] = {};
+
+    /**
+     * Draws the rain through the engine's rain drawer and marks the blocks it draws to.
+     */
+    class TextureRainDrawer final : public IRainDrawer
+    {
+    private:
+        HardwareDisplayDrawingEngine * const _engine;
+
+    public:
+        explicit TextureRainDrawer(HardwareDisplayDrawingEngine * engine)
+            : _engine(engine)
+        {
+        }
+
+        void Draw(sint32 x, sint32 y, sint32 width, sint32 height, sint32 xStart, sint32 yStart) override
+        {
+            _engine->_rainDrawer.Draw(x, y, width, height, xStart, yStart);
+            _engine->_rainRects.push_back({ x, y, width, height });
+            _engine->InvalidateTexture(x, y, x + width, y + height);
+        }
+    };
     
     bool    smoothNN = false;
 
@@ -162,6 +199,10 @@ public:
         _screenTextureFormat = SDL_AllocFormat(format);
 
         ConfigureBits(width, height, width);
+
+        _textureDirtyBlocks.assign(_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows, 0);
+        _textureBits.assign(_width * _height, 0);
+        _textureInvalidated = true;
     }
 
     void SetPalette(const rct_palette_entry * palette) override
@@ -172,6 +213,7 @@ public:
             {
                 _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].red, palette[i].green, palette[i].blue);
             }
+            _textureInvalidated = true;
 
 #ifdef __ENABLE_LIGHTFX__
             if (gConfigGeneral.enable_light_fx)
@@ -187,6 +229,29 @@ public:
         }
     }
 
+    void Invalidate(sint32 left, sint32 top, sint32 right, sint32 bottom) override
+    {
+        X8DrawingEngine::Invalidate(left, top, right, bottom);
+        InvalidateTexture(left, top, right, bottom);
+    }
+
+    void BeginDraw() override
+    {
+        // The rain drawn last frame is restored by the base engine
+        for (const auto &rect : _rainRects)
+        {
+            InvalidateTexture(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
+        }
+        _rainRects.clear();
+        X8DrawingEngine::BeginDraw();
+    }
+
+    void PaintRain() override
+    {
+        TextureRainDrawer rainDrawer(this);
+        DrawRain(&_bitsDPI, &rainDrawer);
+    }
+
     void EndDraw() override
     {
         Display();
@@ -199,6 +264,18 @@ public:
 protected:
     void OnDrawDirtyBlock(uint32 left, uint32 top, uint32 columns, uint32 rows) override
     {
+        for (uint32 y = top; y < top + rows; y++)
+        {
+            for (uint32 x = left; x < left + columns; x++)
+            {
+                uint32 i = y * _dirtyGrid.BlockColumns + x;
+                if (i < _textureDirtyBlocks.size())
+                {
+                    _textureDirtyBlocks[i] = 1;
+                }
+            }
+        }
+
         if (gShowDirtyVisuals)
         {
             uint32 right = left + columns;
@@ -216,6 +293,13 @@ protected:
 private:
     void Display()
     {
+        // The intro is drawn straight to the screen
+        if (gIntroState != INTRO_STATE_NONE)
+        {
+            _textureInvalidated = true;
+        }
+        InvalidateMovedViewports();
+
 #ifdef __ENABLE_LIGHTFX__
         if (gConfigGeneral.enable_light_fx)
         {
@@ -226,6 +310,7 @@ private:
                 lightfx_render_to_texture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _textureInvalidated = true;
         }
         else
 #endif
@@ -266,6 +351,12 @@ private:
 
     void CopyBitsToTexture(SDL_Texture * texture, uint8 * src, sint32 width, sint32 height, const uint32 * palette)
     {
+        if (_screenTextureFormat->BytesPerPixel == 4 && _textureBits.size() == (size_t)(width * height))
+        {
+            CopyChangedBlocksToTexture(texture, src, palette);
+            return;
+        }
+
         void *  pixels;
         sint32     pitch;
         if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
@@ -312,6 +403,103 @@ private:
         }
     }
 
+    void CopyChangedBlocksToTexture(SDL_Texture * texture, const uint8 * src, const uint32 * palette)
+    {
+        uint32 blockWidth = _dirtyGrid.BlockWidth;
+        uint32 blockHeight = _dirtyGrid.BlockHeight;
+        for (uint32 by = 0; by < _dirtyGrid.BlockRows; by++)
+        {
+            uint32 top = by * blockHeight;
+            uint32 bottom = std::min(top + blockHeight, _height);
+            if (top >= bottom)
+            {
+                break;
+            }
+
+            // Convert the changed blocks of this row and upload consecutive ones as a single rectangle
+            uint32 spanStart = 0;
+            uint32 spanEnd = 0;
+            for (uint32 bx = 0; bx <= _dirtyGrid.BlockColumns; bx++)
+            {
+                uint32 left = bx * blockWidth;
+                uint32 right = std::min(left + blockWidth, _width);
+                bool changed = false;
+                if (bx < _dirtyGrid.BlockColumns && left < right)
+                {
+                    uint8 &dirtyBlock = _textureDirtyBlocks[by * _dirtyGrid.BlockColumns + bx];
+                    changed = _textureInvalidated || dirtyBlock != 0;
+                    dirtyBlock = 0;
+                }
+
+                if (changed)
+                {
+                    for (uint32 y = top; y < bottom; y++)
+                    {
+                        palette_to_rgba_fn(src + y * _pitch + left, &_textureBits[y * _width + left], palette, right - left);
+                    }
+                    if (spanEnd == spanStart)
+                    {
+                        spanStart = left;
+                    }
+                    spanEnd = right;
+                }
+                else if (spanEnd != spanStart)
+                {
+                    SDL_Rect rect = { (sint32)spanStart, (sint32)top, (sint32)(spanEnd - spanStart), (sint32)(bottom - top) };
+                    SDL_UpdateTexture(texture, &rect, &_textureBits[top * _width + spanStart], _width * sizeof(uint32));
+                    spanStart = spanEnd = 0;
+                }
+            }
+        }
+        _textureInvalidated = false;
+    }
+
+    void InvalidateTexture(sint32 left, sint32 top, sint32 right, sint32 bottom)
+    {
+        left = std::max(left, 0);
+        top = std::max(top, 0);
+        right = std::min(right, (sint32)_width);
+        bottom = std::min(bottom, (sint32)_height);
+        if (left >= right || top >= bottom)
+        {
+            return;
+        }
+
+        for (sint32 y = top >> _dirtyGrid.BlockShiftY; y <= (bottom - 1) >> _dirtyGrid.BlockShiftY; y++)
+        {
+            for (sint32 x = left >> _dirtyGrid.BlockShiftX; x <= (right - 1) >> _dirtyGrid.BlockShiftX; x++)
+            {
+                size_t i = y * _dirtyGrid.BlockColumns + x;
+                if (i < _textureDirtyBlocks.size())
+                {
+                    _textureDirtyBlocks[i] = 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * Viewports that scrolled since the last frame have been shifted and partly redrawn directly on
+     * the screen, see viewport_move.
+     */
+    void InvalidateMovedViewports()
+    {
+        for (sint32 i = 0; i < MAX_VIEWPORT_COUNT; i++)
+        {
+            const rct_viewport * viewport = &g_viewport_list[i];
+            rct_viewport * last = &_textureViewports[i];
+            if (viewport->width != 0 &&
+                (viewport->x != last->x || viewport->y != last->y ||
+                 viewport->width != last->width || viewport->height != last->height ||
+                 viewport->view_x != last->view_x || viewport->view_y != last->view_y ||
+                 viewport->zoom != last->zoom))
+            {
+                InvalidateTexture(viewport->x, viewport->y, viewport->x + viewport->width, viewport->y + viewport->height);
+            }
+            *last = *viewport;
+        }
+    }
+
     uint32 GetDirtyVisualTime(uint32 x, uint32 y)
     {
         uint32 result = 0;
@@ -14,7 +14,10 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
+#include <vector>
 
 #include <openrct2/config/Config.h>
 #include <openrct2-ui/windows/Window.h>
@@ -162,6 +165,19 @@ static uint32 _window_guest_list_groups_argument_2[240];
 static uint8 _window_guest_list_groups_guest_faces[240 * 58];
 static uint8 _window_guest_list_group_index[240];
 
+struct guest_list_group
+{
+    uint32 argument_1;
+    uint32 argument_2;
+    uint32 num_guests;
+    uint8  faces[56];
+};
+
+// Scratch space for window_guest_list_find_groups, kept to avoid reallocating on every refresh
+static std::vector<guest_list_group> _window_guest_list_all_groups;
+static std::vector<const guest_list_group *> _window_guest_list_sorted_groups;
+static std::unordered_map<uint64, size_t> _window_guest_list_group_lookup;
+
 static char _window_guest_list_filter_name[32];
 
 static sint32 window_guest_list_is_peep_in_filter(rct_peep* peep);
@@ -934,8 +950,8 @@ static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32*
  */
 static void window_guest_list_find_groups()
 {
-    sint32 spriteIndex, spriteIndex2, groupIndex, faceIndex;
-    rct_peep *peep, *peep2;
+    uint16 spriteIndex;
+    rct_peep *peep;
 
     uint32 tick256 = floor2(gScenarioTicks, 256);
     if (_window_guest_list_selected_view == _window_guest_list_last_find_groups_selected_view) {
@@ -951,102 +967,69 @@ static void window_guest_list_find_groups()
     _window_guest_list_last_find_groups_wait = 320;
     _window_guest_list_num_groups = 0;
 
-    // Set all guests to unassigned
-    FOR_ALL_GUESTS(spriteIndex, peep)
-        if (peep->outside_of_park == 0)
-            peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
-
-    // For each guest / group
+    // Group all guests in the park in a single pass, groups are kept in order of their first guest
+    auto &groups = _window_guest_list_all_groups;
+    auto &lookup = _window_guest_list_group_lookup;
+    groups.clear();
+    lookup.clear();
     FOR_ALL_GUESTS(spriteIndex, peep) {
-        if (peep->outside_of_park != 0 || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
+        if (peep->outside_of_park != 0)
             continue;
 
-        // New group, cap at 240 though
-        groupIndex = _window_guest_list_num_groups;
-        if (groupIndex >= 240)
-            break;
-
-        _window_guest_list_num_groups++;
-        _window_guest_list_groups_num_guests[groupIndex] = 1;
-        peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-        get_arguments_from_peep( peep, &_window_guest_list_groups_argument_1[groupIndex], &_window_guest_list_groups_argument_2[groupIndex]);
-        memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[groupIndex], 4);
-        memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[groupIndex], 4);
+        uint32 argument1, argument2;
+        get_arguments_from_peep(peep, &argument1, &argument2);
 
-        _window_guest_list_group_index[groupIndex] = groupIndex;
-        faceIndex = groupIndex * 56;
-        _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-
-        // Find more peeps that belong to same group
-        FOR_ALL_GUESTS(spriteIndex2, peep2) {
-            if (peep2->outside_of_park != 0 || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-                continue;
-
-            uint32 argument1, argument2;
-            // Get and check if in same group
-            get_arguments_from_peep(peep2, &argument1, &argument2);
-            if (argument1 != _window_guest_list_groups_argument_1[groupIndex] || argument2 != _window_guest_list_groups_argument_2[groupIndex] )
-                continue;
-
-            // Assign guest
-            _window_guest_list_groups_num_guests[groupIndex]++;
-            peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-            // Add face sprite, cap at 56 though
-            if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
-                continue;
-            _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+        auto result = lookup.emplace(((uint64)argument2 << 32) | argument1, groups.size());
+        if (result.second) {
+            groups.push_back({ argument1, argument2, 0, {} });
         }
 
-        if (_window_guest_list_filter_arguments[0] == 0) {
-            _window_guest_list_num_groups--;
-            continue;
-        }
-
-        sint32 curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-        sint32 swap_position = 0;
-        //This section places the groups in size order.
-        bool gotoNextPeep = false;
-        while (1) {
-            if (swap_position >= groupIndex) {
-                gotoNextPeep = true;
-                break;
-            }
-            if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
-                break;
-            swap_position++;
-        }
-        if (gotoNextPeep) {
-            continue;
-        }
-
-        sint32 argument_1 = _window_guest_list_groups_argument_1[groupIndex];
-        sint32 argument_2 = _window_guest_list_groups_argument_2[groupIndex];
-        sint32 bl = _window_guest_list_group_index[groupIndex];
+        // Add face sprite, cap at 56 though
+        guest_list_group &group = groups[result.first->second];
+        group.num_guests++;
+        if (group.num_guests < 56)
+            group.faces[group.num_guests - 1] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+    }
 
-        do {
-            sint32 temp = curr_num_guests;
-            curr_num_guests = _window_guest_list_groups_num_guests[swap_position];
-            _window_guest_list_groups_num_guests[swap_position] = temp;
+    // Take the first 240 groups that have a description
+    auto &sortedGroups = _window_guest_list_sorted_groups;
+    sortedGroups.clear();
+    const guest_list_group * lastGroup = nullptr;
+    for (const auto &group : groups) {
+        if (sortedGroups.size() >= 240)
+            break;
 
-            temp = argument_1;
-            argument_1 = _window_guest_list_groups_argument_1[swap_position];
-            _window_guest_list_groups_argument_1[swap_position] = temp;
+        lastGroup = &group;
+        if ((group.argument_1 & 0xFFFF) == 0)
+            continue;
 
-            temp = argument_2;
-            argument_2 = _window_guest_list_groups_argument_2[swap_position];
-            _window_guest_list_groups_argument_2[swap_position] = temp;
+        sortedGroups.push_back(&group);
+    }
 
-            uint8 temp_faces[56];
-            memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex*56]), 56);
-            memcpy(&(_window_guest_list_groups_guest_faces[groupIndex * 56]), &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-            memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
+    // The last group is left in the filter arguments like before
+    if (lastGroup != nullptr) {
+        memcpy(_window_guest_list_filter_arguments + 0, &lastGroup->argument_1, 4);
+        memcpy(_window_guest_list_filter_arguments + 2, &lastGroup->argument_2, 4);
+    }
 
-            temp = _window_guest_list_group_index[swap_position];
-            _window_guest_list_group_index[swap_position] = bl;
-            bl = temp;
-        } while (++swap_position <= groupIndex);
+    // Place the groups in size order, equally sized groups stay in order of their first guest
+    std::vector<uint8> groupIndices(sortedGroups.size());
+    for (size_t i = 0; i < groupIndices.size(); i++) {
+        groupIndices[i] = (uint8)i;
+    }
+    std::stable_sort(groupIndices.begin(), groupIndices.end(), [&sortedGroups](uint8 a, uint8 b) -> bool
+    {
+        return sortedGroups[a]->num_guests > sortedGroups[b]->num_guests;
+    });
+
+    _window_guest_list_num_groups = (sint32)groupIndices.size();
+    for (sint32 i = 0; i < _window_guest_list_num_groups; i++) {
+        const guest_list_group * group = sortedGroups[groupIndices[i]];
+        _window_guest_list_groups_num_guests[i] = (uint16)group->num_guests;
+        _window_guest_list_groups_argument_1[i] = group->argument_1;
+        _window_guest_list_groups_argument_2[i] = group->argument_2;
+        _window_guest_list_group_index[i] = groupIndices[i];
+        memcpy(&_window_guest_list_groups_guest_faces[i * 56], group->faces, 56);
     }
 }
 
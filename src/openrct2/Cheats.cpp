@@ -282,6 +282,7 @@ static void cheat_set_guest_parameter(sint32 parameter, sint32 value)
         case GUEST_PARAMETER_HAPPINESS:
             peep->happiness = value;
             peep->happiness_target = value;
+            park_rating_guest_changed(peep);
             // Clear the 'red-faced with anger' status if we're making the guest happy
             if (value > 0)
             {
@@ -126,10 +126,12 @@ namespace OpenRCT2
 
         ~Context() override
         {
+            scenario_save_async_wait();
             window_close_all();
             http_dispose();
             language_close_all();
             object_manager_unload_all_objects();
+            scrolling_text_dispose();
             gfx_object_check_all_images_freed();
             gfx_unload_g2();
             gfx_unload_g1();
@@ -14,6 +14,7 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <chrono>
 #include <memory>
 #include "audio/audio.h"
 #include "Cheats.h"
@@ -88,6 +89,8 @@ uint8 gUnk141F568;
 
 uint32 gCurrentTicks;
 
+static uint64 * _gameLogicStepTimings = nullptr;
+
 GAME_COMMAND_CALLBACK_POINTER * game_command_callback = nullptr;
 static GAME_COMMAND_CALLBACK_POINTER * const game_command_callback_table[] = {
     nullptr,
@@ -445,6 +448,30 @@ void game_update()
     gInUpdateCode         = false;
 }
 
+/**
+ * Sets the array that receives the time spent in each step of game_logic_update, in nanoseconds.
+ * The array must have GAME_LOGIC_STEP_COUNT elements, times are added to the existing values.
+ * Pass nullptr to stop timing.
+ */
+void game_logic_set_step_timings(uint64 * timings)
+{
+    _gameLogicStepTimings = timings;
+}
+
+static void game_logic_run_step(GAME_LOGIC_STEP step, void (*stepFn)())
+{
+    if (_gameLogicStepTimings == nullptr)
+    {
+        stepFn();
+        return;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    stepFn();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    _gameLogicStepTimings[step] += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+}
+
 void game_logic_update()
 {
     gScreenAge++;
@@ -474,28 +501,29 @@ void game_logic_update()
         network_check_desynchronization();
     }
 
-    sub_68B089();
-    scenario_update();
-    climate_update();
-    map_update_tiles();
+    game_logic_run_step(GAME_LOGIC_STEP_MAP_ELEMENTS, sub_68B089);
+    game_logic_run_step(GAME_LOGIC_STEP_MAP_ELEMENTS, map_compact_elements_step);
+    game_logic_run_step(GAME_LOGIC_STEP_SCENARIO, scenario_update);
+    game_logic_run_step(GAME_LOGIC_STEP_CLIMATE, climate_update);
+    game_logic_run_step(GAME_LOGIC_STEP_MAP_TILES, map_update_tiles);
     // Temporarily remove provisional paths to prevent peep from interacting with them
-    map_remove_provisional_elements();
-    map_update_path_wide_flags();
-    peep_update_all();
-    map_restore_provisional_elements();
-    vehicle_update_all();
-    sprite_misc_update_all();
-    ride_update_all();
-    park_update();
-    research_update();
-    ride_ratings_update_all();
-    ride_measurements_update();
-    news_item_update_current();
-
-    map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+    game_logic_run_step(GAME_LOGIC_STEP_PATHS, map_remove_provisional_elements);
+    game_logic_run_step(GAME_LOGIC_STEP_PATHS, map_update_path_wide_flags);
+    game_logic_run_step(GAME_LOGIC_STEP_PEEPS, peep_update_all);
+    game_logic_run_step(GAME_LOGIC_STEP_PATHS, map_restore_provisional_elements);
+    game_logic_run_step(GAME_LOGIC_STEP_VEHICLES, vehicle_update_all);
+    game_logic_run_step(GAME_LOGIC_STEP_MISC_SPRITES, sprite_misc_update_all);
+    game_logic_run_step(GAME_LOGIC_STEP_RIDES, ride_update_all);
+    game_logic_run_step(GAME_LOGIC_STEP_PARK, park_update);
+    game_logic_run_step(GAME_LOGIC_STEP_RESEARCH, research_update);
+    game_logic_run_step(GAME_LOGIC_STEP_RIDE_RATINGS, ride_ratings_update_all);
+    game_logic_run_step(GAME_LOGIC_STEP_RIDE_MEASUREMENTS, ride_measurements_update);
+    game_logic_run_step(GAME_LOGIC_STEP_NEWS, news_item_update_current);
+
+    game_logic_run_step(GAME_LOGIC_STEP_MAP_ANIMATIONS, map_animation_invalidate_all);
+    game_logic_run_step(GAME_LOGIC_STEP_SOUNDS, vehicle_sounds_update);
+    game_logic_run_step(GAME_LOGIC_STEP_SOUNDS, peep_update_crowd_noise);
+    game_logic_run_step(GAME_LOGIC_STEP_SOUNDS, climate_update_sound);
     editor_open_windows_for_current_step();
 
     // Update windows
@@ -1584,6 +1612,9 @@ void game_autosave()
              currentDate.year, currentDate.month, currentDate.day, currentTime.hour,
              currentTime.minute, currentTime.second, fileExtension);
 
+    // The previous autosave may still be written, it must be complete before it is backed up or removed
+    scenario_save_async_wait();
+
     limit_autosave_count(NUMBER_OF_AUTOSAVES_TO_KEEP, (gScreenFlags & SCREEN_FLAGS_EDITOR));
 
     utf8 path[MAX_PATH];
@@ -1602,7 +1633,7 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    scenario_save(path, saveFlags);
+    scenario_save_async(path, saveFlags);
 }
 
 static void game_load_or_quit_no_save_prompt_callback(sint32 result, const utf8 * path)
@@ -118,6 +118,27 @@ enum
     GAME_PAUSED_SAVING_TRACK = 1 << 2,
 };
 
+enum GAME_LOGIC_STEP
+{
+    GAME_LOGIC_STEP_MAP_ELEMENTS,
+    GAME_LOGIC_STEP_SCENARIO,
+    GAME_LOGIC_STEP_CLIMATE,
+    GAME_LOGIC_STEP_MAP_TILES,
+    GAME_LOGIC_STEP_PATHS,
+    GAME_LOGIC_STEP_PEEPS,
+    GAME_LOGIC_STEP_VEHICLES,
+    GAME_LOGIC_STEP_MISC_SPRITES,
+    GAME_LOGIC_STEP_RIDES,
+    GAME_LOGIC_STEP_PARK,
+    GAME_LOGIC_STEP_RESEARCH,
+    GAME_LOGIC_STEP_RIDE_RATINGS,
+    GAME_LOGIC_STEP_RIDE_MEASUREMENTS,
+    GAME_LOGIC_STEP_NEWS,
+    GAME_LOGIC_STEP_MAP_ANIMATIONS,
+    GAME_LOGIC_STEP_SOUNDS,
+    GAME_LOGIC_STEP_COUNT
+};
+
 enum
 {
     ERROR_TYPE_NONE      = 0,
@@ -163,6 +184,7 @@ void game_reduce_game_speed();
 void game_create_windows();
 void game_update();
 void game_logic_update();
+void game_logic_set_step_timings(uint64 * timings);
 void reset_all_sprite_quadrant_placements();
 void update_palette_effects();
 
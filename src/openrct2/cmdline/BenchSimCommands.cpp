@@ -0,0 +1,193 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../Game.h"
+#include "../Intro.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+#include "../scenario/Scenario.h"
+#include "../world/Sprite.h"
+#include "CommandLine.hpp"
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSimCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [ticks]", nullptr, HandleBenchSim),
+    CommandTableEnd
+};
+
+static const char * const StepNames[GAME_LOGIC_STEP_COUNT] =
+{
+    "map elements",
+    "scenario",
+    "climate",
+    "map tiles",
+    "paths",
+    "peeps",
+    "vehicles",
+    "misc sprites",
+    "rides",
+    "park",
+    "research",
+    "ride ratings",
+    "ride measurements",
+    "news",
+    "map animations",
+    "sounds",
+};
+
+static double GetPercentileMicroseconds(std::vector<uint64> &samples, double percentile)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, (size_t)(percentile * (samples.size() - 1) + 0.5));
+    return samples[index] / 1000.0;
+}
+
+static void WriteTimings(const char * name, std::vector<uint64> &samples, uint64 totalNs, uint64 allStepsNs)
+{
+    double share = allStepsNs == 0 ? 0 : (100.0 * totalNs) / allStepsNs;
+    double mean = samples.empty() ? 0 : (totalNs / 1000.0) / samples.size();
+    Console::WriteLine("%-18s %10.2f %5.1f%% %10.2f %10.2f %10.2f",
+        name,
+        totalNs / 1000000.0,
+        share,
+        mean,
+        GetPercentileMicroseconds(samples, 0.5),
+        GetPercentileMicroseconds(samples, 0.99));
+}
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator)
+{
+    const char * inputPath;
+    if (!argEnumerator->TryPopString(&inputPath))
+    {
+        Console::Error::WriteLine("Usage: openrct2 benchsim <file> [ticks]");
+        return EXITCODE_FAIL;
+    }
+
+    sint32 tickCount = 1000;
+    const char * tickCountArg;
+    if (argEnumerator->TryPopString(&tickCountArg))
+    {
+        tickCount = atoi(tickCountArg);
+    }
+    if (tickCount <= 0)
+    {
+        Console::Error::WriteLine("Tick count must be a positive number.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        return EXITCODE_FAIL;
+    }
+
+    try
+    {
+        if (!context->LoadParkFromFile(inputPath))
+        {
+            Console::Error::WriteLine("Unable to load park: %s", inputPath);
+            return EXITCODE_FAIL;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return EXITCODE_FAIL;
+    }
+
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    // Per tick samples of each step and of the whole tick
+    std::vector<uint64> stepSamples[GAME_LOGIC_STEP_COUNT];
+    std::vector<uint64> tickSamples;
+    uint64 stepTotals[GAME_LOGIC_STEP_COUNT] = {};
+    for (auto &samples : stepSamples)
+    {
+        samples.reserve(tickCount);
+    }
+    tickSamples.reserve(tickCount);
+
+    Console::WriteLine("Running %d ticks of %s...", tickCount, inputPath);
+
+    uint64 stepTimings[GAME_LOGIC_STEP_COUNT];
+    game_logic_set_step_timings(stepTimings);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (sint32 i = 0; i < tickCount; i++)
+    {
+        std::fill_n(stepTimings, GAME_LOGIC_STEP_COUNT, 0);
+
+        auto tickStartTime = std::chrono::high_resolution_clock::now();
+        game_logic_update();
+        auto tickEndTime = std::chrono::high_resolution_clock::now();
+        tickSamples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(tickEndTime - tickStartTime).count());
+
+        for (sint32 step = 0; step < GAME_LOGIC_STEP_COUNT; step++)
+        {
+            stepSamples[step].push_back(stepTimings[step]);
+            stepTotals[step] += stepTimings[step];
+        }
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    game_logic_set_step_timings(nullptr);
+
+    std::chrono::duration<double> duration = endTime - startTime;
+    uint64 allStepsNs = 0;
+    for (uint64 total : stepTotals)
+    {
+        allStepsNs += total;
+    }
+    uint64 tickTotalNs = 0;
+    for (uint64 sample : tickSamples)
+    {
+        tickTotalNs += sample;
+    }
+
+    Console::WriteLine("Ran %d ticks in %.3f seconds (%.1f ticks/sec).", tickCount, duration.count(), tickCount / duration.count());
+    Console::WriteLine();
+    Console::WriteLine("%-18s %10s %6s %10s %10s %10s", "step", "total ms", "share", "mean us", "p50 us", "p99 us");
+    for (sint32 step = 0; step < GAME_LOGIC_STEP_COUNT; step++)
+    {
+        WriteTimings(StepNames[step], stepSamples[step], stepTotals[step], allStepsNs);
+    }
+    WriteTimings("tick", tickSamples, tickTotalNs, tickTotalNs);
+    Console::WriteLine();
+
+    const char * checksum = sprite_checksum();
+    Console::WriteLine("srand0: %08x", gScenarioSrand0);
+    Console::WriteLine("Sprite checksum: %s", checksum != nullptr ? checksum : "n/a");
+    return EXITCODE_OK;
+}
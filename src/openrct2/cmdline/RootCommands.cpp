@@ -139,6 +139,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("screenshot", CommandLine::ScreenshotCommands),
     DefineSubCommand("sprite",     CommandLine::SpriteCommands    ),
     DefineSubCommand("benchgfx",   CommandLine::BenchGfxCommands  ),
+    DefineSubCommand("benchsim",   CommandLine::BenchSimCommands  ),
 
     CommandTableEnd
 };
@@ -50,6 +50,8 @@ struct GeneralConfiguration
     bool        render_weather_gloom;
     bool        disable_lightning_effect;
     bool        show_guest_purchases;
+    bool        multithreading;
+    sint32      scrolling_text_cache_size;
 
     // Localisation
     sint32      language;
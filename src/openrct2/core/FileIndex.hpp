@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <tuple>
@@ -25,6 +27,7 @@
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
+#include "JobPool.hpp"
 #include "Path.hpp"
 
 template<typename TItem>
@@ -64,6 +67,8 @@ private:
 
     // Index file format version which when incremented forces a rebuild
     static constexpr uint8 FILE_INDEX_VERSION = 4;
+    // Number of files indexed by a single task of the job pool
+    static constexpr size_t FILES_PER_TASK = 16;
 
     std::string const _name;
     uint32 const _magicNumber;
@@ -133,6 +138,9 @@ public:
 protected:
     /**
      * Loads the given file and creates the item representing the data to store in the index.
+     * Called from several worker threads at once while the index is being built, so it may only
+     * read global state that does not change while indexing (e.g. the current language) and must
+     * not write to any. Failures should be logged with the file path, an exception skips the file.
      * TODO Use std::optional when C++17 is available.
      */
     virtual std::tuple<bool, TItem> Create(const std::string &path) const abstract;
@@ -181,20 +189,54 @@ private:
     std::vector<TItem> Build(const ScanResult &scanResult) const
     {
         std::vector<TItem> items;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        const auto &files = scanResult.Files;
+        Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
 
         auto startTime = std::chrono::high_resolution_clock::now();
-        // Start at 1, so that we can reach 100% completion status
-        size_t i = 1;
-        for (auto filePath : scanResult.Files)
+
+        // Files are indexed on all cores, each result is stored at the position of its file so the
+        // items end up in scan order regardless of which thread finished first
+        std::vector<std::tuple<bool, TItem>> results(files.size());
+        std::atomic<size_t> processed = { 0 };
+        {
+            JobPool jobPool;
+            for (size_t start = 0; start < files.size(); start += FILES_PER_TASK)
+            {
+                size_t end = std::min(start + FILES_PER_TASK, files.size());
+                jobPool.AddTask([this, &files, &results, &processed, start, end]() -> void
+                {
+                    for (size_t j = start; j < end; j++)
+                    {
+                        log_verbose("FileIndex:Indexing '%s'", files[j].c_str());
+                        try
+                        {
+                            results[j] = Create(files[j]);
+                        }
+                        catch (const std::exception &e)
+                        {
+                            // Exceptions can not leave a worker thread, skip the file instead
+                            Console::Error::WriteLine("Unable to index '%s': %s", files[j].c_str(), e.what());
+                        }
+                        catch (...)
+                        {
+                            Console::Error::WriteLine("Unable to index '%s'", files[j].c_str());
+                        }
+                        processed++;
+                    }
+                });
+            }
+            jobPool.Join([&files, &processed]() -> void
+            {
+                size_t i = processed;
+                Console::WriteFormat("File %5d of %d, done %3d%%\r", i, files.size(), i * 100 / files.size());
+            });
+        }
+
+        for (auto &result : results)
         {
-            Console::WriteFormat("File %5d of %d, done %3d%%\r", i, scanResult.Files.size(), i * 100 / scanResult.Files.size());
-            i++;
-            log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
-            auto item = Create(filePath);
-            if (std::get<0>(item))
+            if (std::get<0>(result))
             {
-                items.push_back(std::get<1>(item));
+                items.push_back(std::get<1>(result));
             }
         }
 
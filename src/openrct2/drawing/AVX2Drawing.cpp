@@ -47,6 +47,26 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     }
 }
 
+void palette_to_rgba_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count)
+{
+    const int * table = (const int *)palette;
+    sint32 i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m128i indices1 = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i indices2 = _mm_loadu_si128((const __m128i *)(src + i + 16));
+        const __m256i pixels1  = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices1), 4);
+        const __m256i pixels2  = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(indices1, 8)), 4);
+        const __m256i pixels3  = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices2), 4);
+        const __m256i pixels4  = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(indices2, 8)), 4);
+        _mm256_storeu_si256((__m256i *)(dst + i), pixels1);
+        _mm256_storeu_si256((__m256i *)(dst + i + 8), pixels2);
+        _mm256_storeu_si256((__m256i *)(dst + i + 16), pixels3);
+        _mm256_storeu_si256((__m256i *)(dst + i + 24), pixels4);
+    }
+    palette_to_rgba_scalar(src + i, dst + i, palette, count - i);
+}
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -59,4 +79,9 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void palette_to_rgba_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
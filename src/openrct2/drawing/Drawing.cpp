@@ -28,8 +28,8 @@
 sint32 gLastDrawStringX;
 sint32 gLastDrawStringY;
 
-sint16 gCurrentFontSpriteBase;
-uint16 gCurrentFontFlags;
+thread_local sint16 gCurrentFontSpriteBase;
+thread_local uint16 gCurrentFontFlags;
 
 uint8 gGamePalette[256 * 4];
 uint32 gPaletteEffectFrame;
@@ -493,6 +493,33 @@ void mask_init()
     }
 }
 
+void (*palette_to_rgba_fn)(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count) = nullptr;
+
+/**
+ * Converts count 8-bit palette indices to 32-bit pixels using the given palette of 256 entries.
+ */
+void palette_to_rgba_scalar(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count)
+{
+    for (sint32 i = 0; i < count; i++)
+    {
+        dst[i] = palette[src[i]];
+    }
+}
+
+void palette_to_rgba_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 palette to RGBA function");
+        palette_to_rgba_fn = palette_to_rgba_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar palette to RGBA function");
+        palette_to_rgba_fn = palette_to_rgba_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo *dpi, sint32 x, sint32 y, sint32 colour)
 {
     gfx_fill_rect(dpi, x, y, x, y, colour);
@@ -215,6 +215,14 @@ struct rct_size16
     sint16 height;
 };
 
+struct image_list_stats
+{
+    uint32  allocated_images;
+    uint32  free_images;
+    uint32  free_lists;         // Number of separate free ranges, the fragmentation of the image id space
+    uint32  largest_free_list;  // Most images that can be allocated in one go
+};
+
 #define SPRITE_ID_PALETTE_COLOUR_1(colourId) (IMAGE_TYPE_REMAP | ((colourId) << 19))
 #define SPRITE_ID_PALETTE_COLOUR_2(primaryId, secondaryId) (IMAGE_TYPE_REMAP_2_PLUS | IMAGE_TYPE_REMAP | ((primaryId << 19) | (secondaryId << 24)))
 #define SPRITE_ID_PALETTE_COLOUR_3(primaryId, secondaryId) (IMAGE_TYPE_REMAP_2_PLUS | ((primaryId << 19) | (secondaryId << 24)))
@@ -227,8 +235,9 @@ struct rct_size16
 
 #define MAX_SCROLLING_TEXT_MODES 38
 
-extern sint16 gCurrentFontSpriteBase;
-extern uint16 gCurrentFontFlags;
+// Per thread, as text is measured and formatted by viewport columns painted in parallel
+extern thread_local sint16 gCurrentFontSpriteBase;
+extern thread_local uint16 gCurrentFontFlags;
 
 extern rct_palette_entry gPalette[256];
 extern uint8 gGamePalette[256 * 4];
@@ -291,6 +300,7 @@ bool is_csg_loaded();
 uint32 gfx_object_allocate_images(const rct_g1_element * images, uint32 count);
 void gfx_object_free_images(uint32 baseImageId, uint32 count);
 void gfx_object_check_all_images_freed();
+image_list_stats gfx_object_get_image_list_stats();
 void FASTCALL gfx_bmp_sprite_to_buffer(const uint8* palette_pointer, uint8* unknown_pointer, uint8* source_pointer, uint8* dest_pointer, const rct_g1_element* source_image, rct_drawpixelinfo *dest_dpi, sint32 height, sint32 width, sint32 image_type);
 void FASTCALL gfx_rle_sprite_to_buffer(const uint8* RESTRICT source_bits_pointer, uint8* RESTRICT dest_bits_pointer, const uint8* RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi, sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width);
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint32 tertiary_colour);
@@ -336,6 +346,9 @@ void ttf_draw_string(rct_drawpixelinfo *dpi, const_utf8string text, sint32 colou
 
 // scrolling text
 void scrolling_text_initialise_bitmaps();
+void scrolling_text_begin_frame();
+bool scrolling_text_frame_overflowed();
+void scrolling_text_dispose();
 sint32 scrolling_text_setup(struct paint_session * session, rct_string_id stringId, uint16 scroll, uint16 scrollingMode);
 
 rct_size16 FASTCALL gfx_get_sprite_size(uint32 image_id);
@@ -351,6 +364,12 @@ void mask_init();
 extern void (*mask_fn)(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, const uint8 * RESTRICT colourSrc,
                        uint8 * RESTRICT dst, sint32 maskWrap, sint32 colourWrap, sint32 dstWrap);
 
+void palette_to_rgba_scalar(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count);
+void palette_to_rgba_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count);
+void palette_to_rgba_init();
+
+extern void (*palette_to_rgba_fn)(const uint8 * RESTRICT src, uint32 * RESTRICT dst, const uint32 * RESTRICT palette, sint32 count);
+
 #include "NewDrawing.h"
 
 #endif
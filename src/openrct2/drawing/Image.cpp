@@ -14,8 +14,9 @@
  *****************************************************************************/
 #pragma endregion
 
-#include <algorithm>
-#include <list>
+#include <map>
+#include <set>
+#include <utility>
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
 #include "../OpenRCT2.h"
@@ -26,46 +27,31 @@ constexpr uint32 BASE_IMAGE_ID = 29294;
 constexpr uint32 MAX_IMAGES = 262144;
 constexpr uint32 INVALID_IMAGE_ID = UINT32_MAX;
 
-struct ImageList
-{
-    uint32 BaseId;
-    uint32 Count;
-};
-
-static bool                 _initialised = false;
-static std::list<ImageList> _freeLists;
-static uint32               _allocatedImageCount;
+static bool                                 _initialised = false;
+// Every free list is kept in both sets: by base image id to merge neighbours when images are freed,
+// and by size so that allocation can pick the smallest list that fits.
+static std::map<uint32, uint32>             _freeListsByBase;
+static std::set<std::pair<uint32, uint32>>  _freeListsBySize;
+static uint32                               _allocatedImageCount;
 
 #ifdef DEBUG
-static std::list<ImageList> _allocatedLists;
+static std::map<uint32, uint32> _allocatedLists;
 
 #pragma warning(push)
 #pragma warning(disable : 4505)
 
 static bool AllocatedListContains(uint32 baseImageId, uint32 count)
 {
-    bool contains = std::any_of(
-        _allocatedLists.begin(),
-        _allocatedLists.end(),
-        [baseImageId, count](const ImageList &imageList) -> bool
-        {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    return contains;
+    auto foundItem = _allocatedLists.find(baseImageId);
+    return foundItem != _allocatedLists.end() && foundItem->second == count;
 }
 
 #pragma warning(pop)
 
 static bool AllocatedListRemove(uint32 baseImageId, uint32 count)
 {
-    auto foundItem = std::find_if(
-        _allocatedLists.begin(),
-        _allocatedLists.end(),
-        [baseImageId, count](const ImageList &imageList) -> bool
-        {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    if (foundItem != _allocatedLists.end())
+    auto foundItem = _allocatedLists.find(baseImageId);
+    if (foundItem != _allocatedLists.end() && foundItem->second == count)
     {
         _allocatedLists.erase(foundItem);
         return true;
@@ -79,12 +65,25 @@ static uint32 GetNumFreeImagesRemaining()
     return MAX_IMAGES - _allocatedImageCount;
 }
 
+static void AddFreeList(uint32 baseImageId, uint32 count)
+{
+    _freeListsByBase.emplace(baseImageId, count);
+    _freeListsBySize.emplace(count, baseImageId);
+}
+
+static void RemoveFreeList(std::map<uint32, uint32>::iterator it)
+{
+    _freeListsBySize.erase({ it->second, it->first });
+    _freeListsByBase.erase(it);
+}
+
 static void InitialiseImageList()
 {
     Guard::Assert(!_initialised, GUARD_LINE);
 
-    _freeLists.clear();
-    _freeLists.push_back({ BASE_IMAGE_ID, MAX_IMAGES });
+    _freeListsByBase.clear();
+    _freeListsBySize.clear();
+    AddFreeList(BASE_IMAGE_ID, MAX_IMAGES);
 #ifdef DEBUG
     _allocatedLists.clear();
 #endif
@@ -93,59 +92,30 @@ static void InitialiseImageList()
 }
 
 /**
- * Merges all the free lists into one, a process of defragmentation.
+ * Takes the images from the smallest free list that fits, the lowest base image id wins a tie.
  */
-static void MergeFreeLists()
+static uint32 TryAllocateImageList(uint32 count)
 {
-    _freeLists.sort(
-        [](const ImageList &a, const ImageList &b) -> bool
-        {
-            return a.BaseId < b.BaseId;
-        });
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    auto sizeIt = _freeListsBySize.lower_bound({ count, 0 });
+    if (sizeIt == _freeListsBySize.end())
     {
-        bool mergeHappened;
-        do
-        {
-            mergeHappened = false;
-            auto nextIt = std::next(it);
-            if (nextIt != _freeLists.end())
-            {
-                if (it->BaseId + it->Count == nextIt->BaseId)
-                {
-                    // Merge next list into this list
-                    it->Count += nextIt->Count;
-                    _freeLists.erase(nextIt);
-                    mergeHappened = true;
-                }
-            }
-        } while (mergeHappened);
+        return INVALID_IMAGE_ID;
     }
-}
 
-static uint32 TryAllocateImageList(uint32 count)
-{
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    uint32 baseImageId = sizeIt->second;
+    auto baseIt = _freeListsByBase.find(baseImageId);
+    uint32 freeCount = baseIt->second;
+    RemoveFreeList(baseIt);
+    if (freeCount > count)
     {
-        ImageList imageList = *it;
-        if (imageList.Count >= count)
-        {
-            _freeLists.erase(it);
-            if (imageList.Count > count)
-            {
-                ImageList remainder = { imageList.BaseId + count,
-                                        imageList.Count - count };
-                _freeLists.push_back(remainder);
-            }
+        AddFreeList(baseImageId + count, freeCount - count);
+    }
 
 #ifdef DEBUG
-            _allocatedLists.push_back({ imageList.BaseId, count });
+    _allocatedLists.emplace(baseImageId, count);
 #endif
-            _allocatedImageCount += count;
-            return imageList.BaseId;
-        }
-    }
-    return INVALID_IMAGE_ID;
+    _allocatedImageCount += count;
+    return baseImageId;
 }
 
 static uint32 AllocateImageList(uint32 count)
@@ -162,12 +132,6 @@ static uint32 AllocateImageList(uint32 count)
     if (freeImagesRemaining >= count)
     {
         baseImageId = TryAllocateImageList(count);
-        if (baseImageId == INVALID_IMAGE_ID)
-        {
-            // Defragment and try again
-            MergeFreeLists();
-            baseImageId = TryAllocateImageList(count);
-        }
     }
     return baseImageId;
 }
@@ -183,22 +147,24 @@ static void FreeImageList(uint32 baseImageId, uint32 count)
 #endif
     _allocatedImageCount -= count;
 
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    // Merge with the free lists directly before and after, so free space never stays fragmented
+    auto nextIt = _freeListsByBase.lower_bound(baseImageId);
+    if (nextIt != _freeListsByBase.begin())
     {
-        if (it->BaseId + it->Count == baseImageId)
-        {
-            it->Count += count;
-            return;
-        }
-        else if (baseImageId + count == it->BaseId)
+        auto prevIt = std::prev(nextIt);
+        if (prevIt->first + prevIt->second == baseImageId)
         {
-            it->BaseId = baseImageId;
-            it->Count += count;
-            return;
+            baseImageId = prevIt->first;
+            count += prevIt->second;
+            RemoveFreeList(prevIt);
         }
     }
-
-    _freeLists.push_back({ baseImageId, count });
+    if (nextIt != _freeListsByBase.end() && baseImageId + count == nextIt->first)
+    {
+        count += nextIt->second;
+        RemoveFreeList(nextIt);
+    }
+    AddFreeList(baseImageId, count);
 }
 
 uint32 gfx_object_allocate_images(const rct_g1_element * images, uint32 count)
@@ -256,3 +222,15 @@ void gfx_object_check_all_images_freed()
     }
 }
 
+image_list_stats gfx_object_get_image_list_stats()
+{
+    image_list_stats stats = {};
+    stats.allocated_images = _allocatedImageCount;
+    stats.free_images = GetNumFreeImagesRemaining();
+    stats.free_lists = (uint32)_freeListsByBase.size();
+    if (!_freeListsBySize.empty())
+    {
+        stats.largest_free_list = _freeListsBySize.rbegin()->first;
+    }
+    return stats;
+}
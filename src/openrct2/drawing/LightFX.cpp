@@ -24,6 +24,7 @@
 #include "../Game.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
+#include "../paint/Paint.h"
 #include "../ride/Ride.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
@@ -627,7 +628,7 @@ const rct_palette * lightfx_get_palette()
     return &gPalette_light;
 }
 
-void lightfx_add_3d_light(uint32 lightID, uint16 lightIDqualifier, sint16 x, sint16 y, uint16 z, uint8 lightType)
+static void lightfx_add_light_to_back_list(uint32 lightID, uint16 lightIDqualifier, sint16 x, sint16 y, uint16 z, uint8 lightType)
 {
     if (LightListCurrentCountBack == 15999) {
         return;
@@ -668,12 +669,32 @@ void lightfx_add_3d_light(uint32 lightID, uint16 lightIDqualifier, sint16 x, sin
 //  log_warning("new 3d light");
 }
 
-void lightfx_add_3d_light_magic_from_drawing_tile(LocationXY16 mapPosition, sint16 offsetX, sint16 offsetY, sint16 offsetZ, uint8 lightType)
+void lightfx_add_3d_light(paint_session * session, uint32 lightID, uint16 lightIDqualifier, sint16 x, sint16 y, uint16 z, uint8 lightType)
 {
-    sint16 x = mapPosition.x + offsetX;
-    sint16 y = mapPosition.y + offsetY;
+    paint_light light;
+    light.light_id = lightID;
+    light.qualifier = lightIDqualifier;
+    light.x = x;
+    light.y = y;
+    light.z = z;
+    light.type = lightType;
+    session->Lights.push_back(light);
+}
+
+void lightfx_add_session_lights(const paint_session * session)
+{
+    for (const auto &light : session->Lights)
+    {
+        lightfx_add_light_to_back_list(light.light_id, light.qualifier, light.x, light.y, light.z, light.type);
+    }
+}
+
+void lightfx_add_3d_light_magic_from_drawing_tile(paint_session * session, sint16 offsetX, sint16 offsetY, sint16 offsetZ, uint8 lightType)
+{
+    sint16 x = session->MapPosition.x + offsetX;
+    sint16 y = session->MapPosition.y + offsetY;
 
-    switch (get_current_rotation()) {
+    switch (session->CurrentRotation) {
     case 0:
         x += 16;
         y += 16;
@@ -694,7 +715,7 @@ void lightfx_add_3d_light_magic_from_drawing_tile(LocationXY16 mapPosition, sint
         return;
     }
 
-    lightfx_add_3d_light((x << 16) | y, (offsetZ << 8) | LIGHTFX_LIGHT_QUALIFIER_MAP, x, y, offsetZ, lightType);
+    lightfx_add_3d_light(session, (x << 16) | y, (offsetZ << 8) | LIGHTFX_LIGHT_QUALIFIER_MAP, x, y, offsetZ, lightType);
 }
 
 uint32 lightfx_get_light_polution()
@@ -735,21 +756,21 @@ void lightfx_add_lights_magic_vehicles()
             Ride *ride = get_ride(vehicle->ride);
             switch (ride->type) {
             case RIDE_TYPE_OBSERVATION_TOWER:
-                lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y + 16, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
-                lightfx_add_3d_light(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x + 16, vehicle->y, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
-                lightfx_add_3d_light(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x - 16, vehicle->y, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
-                lightfx_add_3d_light(vehicleID, 0x0300 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y - 16, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
+                lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y + 16, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
+                lightfx_add_light_to_back_list(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x + 16, vehicle->y, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
+                lightfx_add_light_to_back_list(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x - 16, vehicle->y, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
+                lightfx_add_light_to_back_list(vehicleID, 0x0300 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y - 16, vehicle->z, LIGHTFX_LIGHT_TYPE_SPOT_3);
                 break;
             case RIDE_TYPE_MINE_TRAIN_COASTER:
             case RIDE_TYPE_GHOST_TRAIN:
                 if (vehicle == vehicle_get_head(vehicle)) {
                     place_x -= offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y -= offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_3);
                 }
                 break;
             case RIDE_TYPE_CHAIRLIFT:
-                lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z - 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
+                lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z - 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
                 break;
             case RIDE_TYPE_BOAT_HIRE:
             case RIDE_TYPE_CAR_RIDE:
@@ -769,43 +790,43 @@ void lightfx_add_lights_magic_vehicles()
                 place_z = vehicle_draw->z;
                 place_x -= offsetLookup[(vehicle_draw->sprite_direction + 0) % 32];
                 place_y -= offsetLookup[(vehicle_draw->sprite_direction + 8) % 32];
-                lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_2);
+                lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_2);
                 place_x -= offsetLookup[(vehicle_draw->sprite_direction + 0) % 32];
                 place_y -= offsetLookup[(vehicle_draw->sprite_direction + 8) % 32];
-                lightfx_add_3d_light(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_2);
+                lightfx_add_light_to_back_list(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z, LIGHTFX_LIGHT_TYPE_SPOT_2);
                 break;
             }
             case RIDE_TYPE_MONORAIL:
-                lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y, vehicle->z + 12, LIGHTFX_LIGHT_TYPE_SPOT_2);
+                lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, vehicle->x, vehicle->y, vehicle->z + 12, LIGHTFX_LIGHT_TYPE_SPOT_2);
                 if (vehicle == vehicle_get_head(vehicle)) {
                     place_x -= offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y -= offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                     place_x -= offsetLookup[(vehicle->sprite_direction + 0) % 32] * 3;
                     place_y -= offsetLookup[(vehicle->sprite_direction + 8) % 32] * 3;
-                    lightfx_add_3d_light(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 if (vehicle == vehicle_get_tail(vehicle)) {
                     place_x += offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y += offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0300 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0300 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                     place_x += offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y += offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0400 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0400 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 break;
             case RIDE_TYPE_MINIATURE_RAILWAY:
                 if (vehicle == vehicle_get_head(vehicle)) {
                     place_x -= offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y -= offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0100 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                     place_x -= offsetLookup[(vehicle->sprite_direction + 0) % 32] * 2;
                     place_y -= offsetLookup[(vehicle->sprite_direction + 8) % 32] * 2;
-                    lightfx_add_3d_light(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0200 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 2, LIGHTFX_LIGHT_TYPE_LANTERN_3);
 
                 }
                 else {
-                    lightfx_add_3d_light(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_light_to_back_list(vehicleID, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, place_x, place_y, place_z + 10, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 break;
             default:
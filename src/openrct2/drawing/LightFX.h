@@ -21,7 +21,7 @@
 
 #include "../common.h"
 
-struct LocationXY16;
+struct paint_session;
 struct rct_drawpixelinfo;
 struct rct_palette;
 
@@ -62,9 +62,12 @@ void lightfx_update_viewport_settings();
 void* lightfx_get_front_buffer();
 const rct_palette * lightfx_get_palette();
 
-void lightfx_add_3d_light(uint32 lightID, uint16 lightIDqualifier, sint16 x, sint16 y, uint16 z, uint8 lightType);
+// Lights found while painting are kept with the session, so that the columns of a viewport can be
+// generated on several threads. They are merged into the light list in column order afterwards.
+void lightfx_add_3d_light(paint_session * session, uint32 lightID, uint16 lightIDqualifier, sint16 x, sint16 y, uint16 z, uint8 lightType);
+void lightfx_add_session_lights(const paint_session * session);
 
-void lightfx_add_3d_light_magic_from_drawing_tile(LocationXY16 mapPosition, sint16 offsetX, sint16 offsetY, sint16 offsetZ, uint8 lightType);
+void lightfx_add_3d_light_magic_from_drawing_tile(paint_session * session, sint16 offsetX, sint16 offsetY, sint16 offsetZ, uint8 lightType);
 
 void lightfx_add_lights_magic_vehicles();
 
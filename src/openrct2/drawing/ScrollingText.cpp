@@ -15,6 +15,8 @@
 #pragma endregion
 
 #include <algorithm>
+#include <mutex>
+#include <vector>
 #include "../config/Config.h"
 #include "../interface/Colour.h"
 #include "../localisation/Localisation.h"
@@ -37,12 +39,34 @@ struct rct_draw_scroll_text {
 assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
-#define MAX_SCROLLING_TEXT_ENTRIES 32
+#define SCROLLING_TEXT_BLOCK_SIZE 32
 
-static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
+/**
+ * The first block uses the images reserved in g1, further blocks allocate their images when
+ * a frame needed more entries than were available, up to the configured cache size. Blocks are
+ * only added by scrolling_text_begin_frame as the image allocator may not be used by the paint
+ * worker threads.
+ */
+struct scrolling_text_block
+{
+    uint32                  base_image_id;
+    rct_draw_scroll_text    entries[SCROLLING_TEXT_BLOCK_SIZE];
+};
+
+static scrolling_text_block _scrollingTextBaseBlock = { SPR_SCROLLING_TEXT_START };
+static std::vector<scrolling_text_block *> _scrollingTextBlocks = { &_scrollingTextBaseBlock };
+static bool _scrollingTextAllocationFailed = false;
 static uint8 _characterBitmaps[FONT_SPRITE_GLYPH_COUNT][8];
 static uint32 _drawSCrollNextIndex = 0;
+// Entries with a newer id have been handed out since the last scrolling_text_begin_frame
+static uint32 _drawScrollFrameStartIndex = 0;
+// Number of texts since the last scrolling_text_begin_frame that got no entry because all were still to be drawn
+static uint32 _drawScrollFrameMissing = 0;
+static std::mutex _scrollingTextMutex;
 
+static void scrolling_text_bind_bitmap(rct_g1_element * g1, rct_draw_scroll_text * scrollText);
+static bool scrolling_text_can_grow();
+static bool scrolling_text_grow();
 static void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 static void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 
@@ -77,48 +101,150 @@ void scrolling_text_initialise_bitmaps()
         }
     }
 
-    for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+    for (sint32 i = 0; i < SCROLLING_TEXT_BLOCK_SIZE; i++)
     {
         sint32 imageId = SPR_SCROLLING_TEXT_START + i;
         const rct_g1_element * g1original = gfx_get_g1_element(imageId);
         if (g1original != nullptr)
         {
             rct_g1_element g1 = *g1original;
-            g1.offset = _drawScrollTextList[i].bitmap;
-            g1.width = 64;
-            g1.height = 40;
-            g1.offset[0] = 0xFF;
-            g1.offset[1] = 0xFF;
-            g1.offset[14] = 0;
-            g1.offset[15] = 0;
-            g1.offset[16] = 0;
-            g1.offset[17] = 0;
+            scrolling_text_bind_bitmap(&g1, &_scrollingTextBaseBlock.entries[i]);
             gfx_set_g1_element(imageId, &g1);
         }
     }
 }
 
+/**
+ * Starts a new set of texts that must all keep their entries until they have been drawn. Must be
+ * called on the main thread, it adds the entries the previous set was missing.
+ */
+void scrolling_text_begin_frame()
+{
+    std::lock_guard<std::mutex> lock(_scrollingTextMutex);
+    while (_drawScrollFrameMissing > 0 && scrolling_text_grow())
+    {
+        _drawScrollFrameMissing -= std::min<uint32>(_drawScrollFrameMissing, SCROLLING_TEXT_BLOCK_SIZE);
+    }
+    _drawScrollFrameStartIndex = _drawSCrollNextIndex;
+    _drawScrollFrameMissing = 0;
+}
+
+/**
+ * Whether texts since the last scrolling_text_begin_frame were given the default image because the cache
+ * was full, and painting them again after another scrolling_text_begin_frame would give them their own.
+ */
+bool scrolling_text_frame_overflowed()
+{
+    std::lock_guard<std::mutex> lock(_scrollingTextMutex);
+    return _drawScrollFrameMissing > 0 && scrolling_text_can_grow();
+}
+
+void scrolling_text_dispose()
+{
+    std::lock_guard<std::mutex> lock(_scrollingTextMutex);
+    for (size_t i = 1; i < _scrollingTextBlocks.size(); i++)
+    {
+        gfx_object_free_images(_scrollingTextBlocks[i]->base_image_id, SCROLLING_TEXT_BLOCK_SIZE);
+        delete _scrollingTextBlocks[i];
+    }
+    _scrollingTextBlocks.resize(1);
+    _scrollingTextAllocationFailed = false;
+}
+
+static void scrolling_text_bind_bitmap(rct_g1_element * g1, rct_draw_scroll_text * scrollText)
+{
+    g1->offset = scrollText->bitmap;
+    g1->width = 64;
+    g1->height = 40;
+    g1->offset[0] = 0xFF;
+    g1->offset[1] = 0xFF;
+    g1->offset[14] = 0;
+    g1->offset[15] = 0;
+    g1->offset[16] = 0;
+    g1->offset[17] = 0;
+}
+
+static size_t scrolling_text_get_max_entries()
+{
+    size_t maxEntries = (size_t)std::max(gConfigGeneral.scrolling_text_cache_size, SCROLLING_TEXT_BLOCK_SIZE);
+    return maxEntries - (maxEntries % SCROLLING_TEXT_BLOCK_SIZE);
+}
+
+static rct_draw_scroll_text * scrolling_text_get_entry(size_t index)
+{
+    return &_scrollingTextBlocks[index / SCROLLING_TEXT_BLOCK_SIZE]->entries[index % SCROLLING_TEXT_BLOCK_SIZE];
+}
+
+static uint32 scrolling_text_get_image_id(size_t index)
+{
+    return _scrollingTextBlocks[index / SCROLLING_TEXT_BLOCK_SIZE]->base_image_id + (uint32)(index % SCROLLING_TEXT_BLOCK_SIZE);
+}
+
+static bool scrolling_text_can_grow()
+{
+    size_t numEntries = _scrollingTextBlocks.size() * SCROLLING_TEXT_BLOCK_SIZE;
+    return !_scrollingTextAllocationFailed && numEntries < scrolling_text_get_max_entries();
+}
+
+/**
+ * Adds a block of entries, returns false if no more blocks can be added.
+ */
+static bool scrolling_text_grow()
+{
+    if (!scrolling_text_can_grow())
+    {
+        return false;
+    }
+
+    const rct_g1_element * g1original = gfx_get_g1_element(SPR_SCROLLING_TEXT_START);
+    if (g1original == nullptr)
+    {
+        _scrollingTextAllocationFailed = true;
+        return false;
+    }
+
+    auto block = new scrolling_text_block();
+    rct_g1_element images[SCROLLING_TEXT_BLOCK_SIZE];
+    for (sint32 i = 0; i < SCROLLING_TEXT_BLOCK_SIZE; i++)
+    {
+        images[i] = *g1original;
+        scrolling_text_bind_bitmap(&images[i], &block->entries[i]);
+    }
+    block->base_image_id = gfx_object_allocate_images(images, SCROLLING_TEXT_BLOCK_SIZE);
+    if (block->base_image_id == UINT32_MAX)
+    {
+        delete block;
+        _scrollingTextAllocationFailed = true;
+        return false;
+    }
+
+    _scrollingTextBlocks.push_back(block);
+    return true;
+}
+
 static uint8 *font_sprite_get_codepoint_bitmap(sint32 codepoint)
 {
     return _characterBitmaps[font_sprite_get_codepoint_offset(codepoint)];
 }
 
 
-static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16 scroll, uint16 scrollingMode)
+static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16 scroll, uint16 scrollingMode, bool * matched)
 {
+    uint32 stringArgs0, stringArgs1;
+    memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
+    memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
+
     uint32 oldestId = 0xFFFFFFFF;
     sint32 scrollIndex = -1;
-    for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++) {
-        rct_draw_scroll_text *scrollText = &_drawScrollTextList[i];
+    sint32 numEntries = (sint32)(_scrollingTextBlocks.size() * SCROLLING_TEXT_BLOCK_SIZE);
+    for (sint32 i = 0; i < numEntries; i++) {
+        rct_draw_scroll_text *scrollText = scrolling_text_get_entry(i);
         if (oldestId >= scrollText->id) {
             oldestId = scrollText->id;
             scrollIndex = i;
         }
 
         // If exact match return the matching index
-        uint32 stringArgs0, stringArgs1;
-        memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
-        memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
         if (
             scrollText->string_id == stringId &&
             scrollText->string_args_0 == stringArgs0 &&
@@ -127,9 +253,17 @@ static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint
             scrollText->mode == scrollingMode
         ) {
             scrollText->id = _drawSCrollNextIndex;
-            return i + SPR_SCROLLING_TEXT_START;
+            *matched = true;
+            return i;
         }
     }
+
+    // Don't overwrite text that is still to be drawn in this frame
+    if (oldestId > _drawScrollFrameStartIndex) {
+        _drawScrollFrameMissing++;
+        scrollIndex = -1;
+    }
+    *matched = false;
     return scrollIndex;
 }
 
@@ -1434,17 +1568,20 @@ sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uin
 
     if (dpi->zoom_level != 0) return SPR_SCROLLING_TEXT_DEFAULT;
 
+    std::lock_guard<std::mutex> lock(_scrollingTextMutex);
     _drawSCrollNextIndex++;
 
-    sint32 scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START) return scrollIndex;
+    bool matched;
+    sint32 scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode, &matched);
+    if (scrollIndex == -1) return SPR_SCROLLING_TEXT_DEFAULT;
+    if (matched) return scrolling_text_get_image_id(scrollIndex);
 
     // Setup scrolling text
     uint32 stringArgs0, stringArgs1;
     memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
     memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
 
-    rct_draw_scroll_text* scrollText = &_drawScrollTextList[scrollIndex];
+    rct_draw_scroll_text* scrollText = scrolling_text_get_entry(scrollIndex);
     scrollText->string_id = stringId;
     scrollText->string_args_0 = stringArgs0;
     scrollText->string_args_1 = stringArgs1;
@@ -1465,7 +1602,7 @@ sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uin
         scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions);
     }
 
-    uint32 imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
+    uint32 imageId = scrolling_text_get_image_id(scrollIndex);
     drawing_engine_invalidate_image(imageId);
     return imageId;
 }
@@ -14,12 +14,16 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../OpenRCT2.h"
 #include "../platform/platform.h"
@@ -46,6 +50,20 @@ struct rct_gx
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
     void * data;
+
+    // Set when the file is memory mapped, data then points into the mapping
+    std::unique_ptr<MemoryMappedFile> file;
+
+    // Set when elements are converted on first use instead of when the file is loaded
+    const rct_g1_element_32bit * fileElements;
+    std::unique_ptr<std::atomic<uint8>[]> elementStates;
+};
+
+enum
+{
+    GX_ELEMENT_UNRESOLVED,
+    GX_ELEMENT_RESOLVING,
+    GX_ELEMENT_RESOLVED,
 };
 
 constexpr struct
@@ -86,10 +104,21 @@ static inline uint32 rctc_to_rct2_index(uint32 image)
     else throw std::runtime_error("Invalid RCTC g1.dat file");
 }
 
-static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc, rct_g1_element *elements)
+static void convert_gx_element(const rct_g1_element_32bit &src, rct_g1_element * element)
+{
+    // Double cast to silence compiler warning about casting to
+    // pointer from integer of mismatched length.
+    element->offset        = (uint8*)(uintptr_t)src.offset;
+    element->width         = src.width;
+    element->height        = src.height;
+    element->x_offset      = src.x_offset;
+    element->y_offset      = src.y_offset;
+    element->flags         = src.flags;
+    element->zoomed_offset = src.zoomed_offset;
+}
+
+static void read_and_convert_gxdat(const rct_g1_element_32bit * g1Elements32, size_t count, bool is_rctc, rct_g1_element *elements)
 {
-    auto g1Elements32 = std::make_unique<rct_g1_element_32bit[]>(count);
-    stream->Read(g1Elements32.get(), count * sizeof(rct_g1_element_32bit));
     if (is_rctc)
     {
         // Process RCTC's g1.dat file
@@ -115,24 +144,11 @@ static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc,
             }
 
             const rct_g1_element_32bit &src = g1Elements32[rctc];
-
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset        = (uint8*)(uintptr_t)src.offset;
-            elements[i].width         = src.width;
-            elements[i].height        = src.height;
-            elements[i].x_offset      = src.x_offset;
-            elements[i].y_offset      = src.y_offset;
-            elements[i].flags         = src.flags;
-
+            convert_gx_element(src, &elements[i]);
             if (src.flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
                 elements[i].zoomed_offset = (uint16) (i - rctc_to_rct2_index(rctc - src.zoomed_offset));
             }
-            else
-            {
-                elements[i].zoomed_offset = src.zoomed_offset;
-            }
 
             ++rctc;
         }
@@ -153,19 +169,111 @@ static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc,
     {
         for (size_t i = 0; i < count; i++)
         {
-            const rct_g1_element_32bit &src = g1Elements32[i];
+            convert_gx_element(g1Elements32[i], &elements[i]);
+        }
+    }
+}
+
+static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc, rct_g1_element *elements)
+{
+    auto g1Elements32 = std::make_unique<rct_g1_element_32bit[]>(count);
+    stream->Read(g1Elements32.get(), count * sizeof(rct_g1_element_32bit));
+    read_and_convert_gxdat(g1Elements32.get(), count, is_rctc, elements);
+}
 
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset        = (uint8*)(uintptr_t)src.offset;
-            elements[i].width         = src.width;
-            elements[i].height        = src.height;
-            elements[i].x_offset      = src.x_offset;
-            elements[i].y_offset      = src.y_offset;
-            elements[i].flags         = src.flags;
-            elements[i].zoomed_offset = src.zoomed_offset;
+/**
+ * Maps a g1.dat style file (header, element table, element data) into memory. The OS only reads
+ * the pages of the sprites that are drawn and shares them with other running instances.
+ * @returns false if the file can not be mapped, the caller should read it instead.
+ */
+static bool gfx_map_gx(rct_gx * gx, const std::string &path)
+{
+    std::unique_ptr<MemoryMappedFile> file;
+    try
+    {
+        file = std::make_unique<MemoryMappedFile>(path);
+    }
+    catch (const std::exception &e)
+    {
+        log_verbose("Unable to map %s: %s", path.c_str(), e.what());
+        return false;
+    }
+
+    auto bytes = (uint8 *)file->GetData();
+    if (file->GetLength() < sizeof(rct_g1_header))
+    {
+        return false;
+    }
+    std::memcpy(&gx->header, bytes, sizeof(rct_g1_header));
+
+    size_t elementsSize = (size_t)gx->header.num_entries * sizeof(rct_g1_element_32bit);
+    if (file->GetLength() - sizeof(rct_g1_header) < elementsSize ||
+        file->GetLength() - sizeof(rct_g1_header) - elementsSize < gx->header.total_size)
+    {
+        return false;
+    }
+    gx->fileElements = (const rct_g1_element_32bit *)(bytes + sizeof(rct_g1_header));
+    gx->data = bytes + sizeof(rct_g1_header) + elementsSize;
+    gx->file = std::move(file);
+    return true;
+}
+
+/**
+ * Defers the conversion of the mapped element table until each element is first requested,
+ * most sprites are never drawn during a session.
+ */
+static void gfx_resolve_gx_lazily(rct_gx * gx)
+{
+    gx->elementStates = std::make_unique<std::atomic<uint8>[]>(gx->header.num_entries);
+    for (uint32 i = 0; i < gx->header.num_entries; i++)
+    {
+        gx->elementStates[i].store(GX_ELEMENT_UNRESOLVED, std::memory_order_relaxed);
+    }
+}
+
+static rct_g1_element * gfx_get_gx_element(rct_gx * gx, uint32 idx)
+{
+    rct_g1_element * element = &gx->elements[idx];
+    if (gx->elementStates != nullptr && idx < gx->header.num_entries)
+    {
+        auto &state = gx->elementStates[idx];
+        if (state.load(std::memory_order_acquire) != GX_ELEMENT_RESOLVED)
+        {
+            // Elements can be requested by several paint threads at once, only one of them converts it
+            uint8 expected = GX_ELEMENT_UNRESOLVED;
+            if (state.compare_exchange_strong(expected, GX_ELEMENT_RESOLVING, std::memory_order_acquire))
+            {
+                convert_gx_element(gx->fileElements[idx], element);
+                element->offset += (uintptr_t)gx->data;
+                state.store(GX_ELEMENT_RESOLVED, std::memory_order_release);
+            }
+            else
+            {
+                while (state.load(std::memory_order_acquire) != GX_ELEMENT_RESOLVED)
+                {
+                    std::this_thread::yield();
+                }
+            }
         }
     }
+    return element;
+}
+
+static void gfx_unload_gx(rct_gx * gx)
+{
+    if (gx->file != nullptr)
+    {
+        gx->file = nullptr;
+        gx->data = nullptr;
+    }
+    else
+    {
+        SafeFree(gx->data);
+    }
+    gx->fileElements = nullptr;
+    gx->elementStates = nullptr;
+    gx->elements.clear();
+    gx->elements.shrink_to_fit();
 }
 
 void mask_scalar(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, const uint8 * RESTRICT colourSrc,
@@ -235,24 +343,49 @@ bool gfx_load_g1(void * platformEnvironment)
     try
     {
         auto path = Path::Combine(env->GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g1.header = fs.ReadValue<rct_g1_header>();
+        if (gfx_map_gx(&_g1, path))
+        {
+            log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
 
-        log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
+            if (_g1.header.num_entries < SPR_G1_END)
+            {
+                throw std::runtime_error("Not enough elements in g1.dat");
+            }
 
-        if (_g1.header.num_entries < SPR_G1_END)
-        {
-            throw std::runtime_error("Not enough elements in g1.dat");
+            _g1.elements.resize(324206);
+            bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
+            gTinyFontAntiAliased = is_rctc;
+            if (!is_rctc)
+            {
+                gfx_resolve_gx_lazily(&_g1);
+                return true;
+            }
+
+            // RCTC elements are rearranged, so they have to be converted up front
+            read_and_convert_gxdat(_g1.fileElements, _g1.header.num_entries, is_rctc, _g1.elements.data());
+            _g1.fileElements = nullptr;
         }
+        else
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            _g1.header = fs.ReadValue<rct_g1_header>();
 
-        // Read element headers
-        _g1.elements.resize(324206);
-        bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
-        read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
-        gTinyFontAntiAliased = is_rctc;
+            log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8>(_g1.header.total_size);
+            if (_g1.header.num_entries < SPR_G1_END)
+            {
+                throw std::runtime_error("Not enough elements in g1.dat");
+            }
+
+            // Read element headers
+            _g1.elements.resize(324206);
+            bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
+            read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
+            gTinyFontAntiAliased = is_rctc;
+
+            // Read element data
+            _g1.data = fs.ReadArray<uint8>(_g1.header.total_size);
+        }
 
         // Fix entry data offsets
         for (uint32 i = 0; i < _g1.header.num_entries; i++)
@@ -263,8 +396,7 @@ bool gfx_load_g1(void * platformEnvironment)
     }
     catch (const std::exception &)
     {
-        _g1.elements.clear();
-        _g1.elements.shrink_to_fit();
+        gfx_unload_gx(&_g1);
 
         log_fatal("Unable to load g1 graphics");
         if (!gOpenRCT2Headless)
@@ -278,23 +410,17 @@ bool gfx_load_g1(void * platformEnvironment)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
-    _g1.elements.clear();
-    _g1.elements.shrink_to_fit();
+    gfx_unload_gx(&_g1);
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
-    _g2.elements.clear();
-    _g2.elements.shrink_to_fit();
+    gfx_unload_gx(&_g2);
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
-    _csg.elements.clear();
-    _csg.elements.shrink_to_fit();
+    gfx_unload_gx(&_csg);
 }
 
 bool gfx_load_g2()
@@ -307,6 +433,13 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
+        if (gfx_map_gx(&_g2, path))
+        {
+            _g2.elements.resize(_g2.header.num_entries);
+            gfx_resolve_gx_lazily(&_g2);
+            return true;
+        }
+
         auto fs = FileStream(path, FILE_MODE_OPEN);
         _g2.header = fs.ReadValue<rct_g1_header>();
 
@@ -326,8 +459,7 @@ bool gfx_load_g2()
     }
     catch (const std::exception &)
     {
-        _g2.elements.clear();
-        _g2.elements.shrink_to_fit();
+        gfx_unload_gx(&_g2);
 
         log_fatal("Unable to load g2 graphics");
         if (!gOpenRCT2Headless)
@@ -371,8 +503,22 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8>(_csg.header.total_size);
+        // Map element data, or read it when that is not possible
+        try
+        {
+            _csg.file = std::make_unique<MemoryMappedFile>(pathDataPath);
+            if (_csg.file->GetLength() < _csg.header.total_size)
+            {
+                throw std::runtime_error("Mapped file is smaller than the data");
+            }
+            _csg.data = _csg.file->GetData();
+        }
+        catch (const std::exception &e)
+        {
+            log_verbose("Unable to map %s: %s", pathDataPath.c_str(), e.what());
+            _csg.file = nullptr;
+            _csg.data = fileData.ReadArray<uint8>(_csg.header.total_size);
+        }
 
         // Fix entry data offsets
         for (uint32 i = 0; i < _csg.header.num_entries; i++)
@@ -386,8 +532,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception &)
     {
-        _csg.elements.clear();
-        _csg.elements.shrink_to_fit();
+        gfx_unload_gx(&_csg);
 
         log_error("Unable to load csg graphics");
         return false;
@@ -793,7 +938,7 @@ const rct_g1_element * gfx_get_g1_element(sint32 image_id)
         {
             return nullptr;
         }
-        return &_g1.elements[image_id];
+        return gfx_get_gx_element(&_g1, image_id);
     }
     if (image_id < SPR_CSG_BEGIN)
     {
@@ -803,7 +948,7 @@ const rct_g1_element * gfx_get_g1_element(sint32 image_id)
             log_warning("Invalid entry in g2.dat requested, idx = %u. You may have to update your g2.dat.", idx);
             return nullptr;
         }
-        return &_g2.elements[idx];
+        return gfx_get_gx_element(&_g2, idx);
     }
 
     if (is_csg_loaded())
@@ -837,6 +982,10 @@ void gfx_set_g1_element(sint32 imageId, const rct_g1_element * g1)
         if (imageId < (sint32)_g1.elements.size())
         {
             _g1.elements[imageId] = *g1;
+            if (_g1.elementStates != nullptr && (uint32)imageId < _g1.header.num_entries)
+            {
+                _g1.elementStates[imageId].store(GX_ELEMENT_RESOLVED, std::memory_order_release);
+            }
         }
     }
 }
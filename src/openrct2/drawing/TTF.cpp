@@ -16,6 +16,7 @@
 
 #ifndef NO_TTF
 
+#include <mutex>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -56,6 +57,9 @@ static sint32 _ttfGetWidthCacheCount = 0;
 static sint32 _ttfGetWidthCacheHitCount = 0;
 static sint32 _ttfGetWidthCacheMissCount = 0;
 
+// Guards both caches and the FreeType faces they render with
+static std::mutex _ttfCacheMutex;
+
 static TTF_Font * ttf_open_font(const utf8 * fontPath, sint32 ptSize);
 static void ttf_close_font(TTF_Font * font);
 static uint32 ttf_surface_cache_hash(TTF_Font * font, const utf8 * text);
@@ -177,6 +181,7 @@ void ttf_toggle_hinting()
 
 TTFSurface * ttf_surface_cache_get_or_add(TTF_Font * font, const utf8 * text)
 {
+    std::lock_guard<std::mutex> lock(_ttfCacheMutex);
     ttf_cache_entry *entry;
 
     uint32 hash = ttf_surface_cache_hash(font, text);
@@ -242,6 +247,7 @@ static void ttf_getwidth_cache_dispose_all()
 
 uint32 ttf_getwidth_cache_get_or_add(TTF_Font * font, const utf8 * text)
 {
+    std::lock_guard<std::mutex> lock(_ttfCacheMutex);
     ttf_getwidth_cache_entry *entry;
 
     uint32 hash = ttf_surface_cache_hash(font, text);
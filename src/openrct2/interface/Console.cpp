@@ -42,6 +42,7 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
+#include "../paint/Paint.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -49,6 +50,7 @@
 #include "../Version.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
+#include "../world/MapAnimation.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
@@ -459,6 +461,9 @@ static sint32 cc_get(InteractiveConsole &console, const utf8 **argv, sint32 argc
         else if (strcmp(argv[0], "no_test_crashes") == 0) {
             console.WriteFormatLine("no_test_crashes %d", gConfigGeneral.no_test_crashes);
         }
+        else if (strcmp(argv[0], "verify_park_rating") == 0) {
+            console.WriteFormatLine("verify_park_rating %d", gParkVerifyRatingAggregates);
+        }
         else if (strcmp(argv[0], "location") == 0) {
             rct_window *w = window_get_main();
             if (w != nullptr) {
@@ -666,6 +671,10 @@ static sint32 cc_set(InteractiveConsole &console, const utf8 **argv, sint32 argc
             config_save_default();
             console.Execute("get no_test_crashes");
         }
+        else if (strcmp(argv[0], "verify_park_rating") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+            gParkVerifyRatingAggregates = (int_val[0] != 0);
+            console.Execute("get verify_park_rating");
+        }
         else if (strcmp(argv[0], "location") == 0 && invalidArguments(&invalidArgs, int_valid[0] && int_valid[1])) {
             rct_window *w = window_get_main();
             if (w != nullptr) {
@@ -957,6 +966,16 @@ static sint32 cc_show_limits(InteractiveConsole &console, const utf8 ** argv, si
     console.WriteFormatLine("Banners: %d/%d", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, MAX_RIDES);
     console.WriteFormatLine("Staff: %d/%d", staffCount, STAFF_MAX_COUNT);
+    console.WriteFormatLine("Map animations: %u", (uint32)map_animation_get_count());
+
+    auto paintStats = paint_get_arena_stats();
+    console.WriteFormatLine("Paint structs (peak per column): %u/%u", paintStats.peak_entries, PAINT_ARENA_CHUNK_SIZE * PAINT_ARENA_MAX_CHUNKS);
+    console.WriteFormatLine("Paint arena chunks: %u (grown %u times, %u entries dropped)",
+        paintStats.total_chunks, paintStats.grown_sessions, paintStats.dropped_entries);
+
+    auto imageStats = gfx_object_get_image_list_stats();
+    console.WriteFormatLine("Object images: %u (%u free in %u ranges, largest %u)",
+        imageStats.allocated_images, imageStats.free_images, imageStats.free_lists, imageStats.largest_free_list);
     return 0;
 }
 
@@ -1054,6 +1073,7 @@ static constexpr const utf8* console_variable_table[] = {
     "console_small_font",
     "test_unfinished_tracks",
     "no_test_crashes",
+    "verify_park_rating",
     "location",
     "window_scale",
     "window_limit",
@@ -16,11 +16,15 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
 #include "../Game.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
@@ -64,7 +68,18 @@ static sint16 _interactionMapX;
 static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
+struct paint_column
+{
+    rct_drawpixelinfo   DPI;
+    paint_session *     Session;
+    paint_struct        PS;
+};
+
+static std::unique_ptr<JobPool> _paintJobs;
+static std::vector<paint_column> _paintColumns;
+
+static void viewport_fill_column(paint_column * column);
+static void viewport_paint_column(paint_column * column, uint32 viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
 /**
@@ -853,7 +868,8 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
     // this as well as the [x += 32] in the loop causes signed integer overflow -> undefined behaviour.
     sint16 rightBorder = dpi1.x + dpi1.width;
 
-    // Splits the area into 32 pixel columns and renders them
+    // Splits the area into 32 pixel columns
+    _paintColumns.clear();
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32) {
         rct_drawpixelinfo dpi2 = dpi1;
         if (x >= dpi2.x) {
@@ -872,14 +888,83 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags);
+        paint_column column = {};
+        column.DPI = dpi2;
+        _paintColumns.push_back(column);
+    }
+
+    gCurrentViewportFlags = viewFlags;
+
+    bool useMultithreading = gConfigGeneral.multithreading && _paintColumns.size() > 1;
+    if (useMultithreading && _paintJobs == nullptr)
+    {
+        _paintJobs = std::make_unique<JobPool>();
+    }
+    else if (!gConfigGeneral.multithreading && _paintJobs != nullptr)
+    {
+        _paintJobs.reset();
+    }
+
+    if (useMultithreading)
+    {
+        // Generate and arrange every column on the job pool, then draw them in order
+        scrolling_text_begin_frame();
+        for (auto &column : _paintColumns)
+        {
+            column.Session = paint_session_alloc(&column.DPI);
+            auto columnPtr = &column;
+            _paintJobs->AddTask([columnPtr]() -> void
+            {
+                viewport_fill_column(columnPtr);
+            });
+        }
+        _paintJobs->Join();
+
+        if (!scrolling_text_frame_overflowed())
+        {
+            // Drawing goes through the drawing engine and shared palettes, so it stays on this thread
+            for (auto &column : _paintColumns)
+            {
+                viewport_paint_column(&column, viewFlags);
+            }
+            return;
+        }
+
+        // The scrolling text cache could not hold every text of the viewport. Throw the columns away
+        // and paint them one at a time instead, which only needs the texts of one column at once.
+        for (auto &column : _paintColumns)
+        {
+            paint_session_free(column.Session);
+        }
+    }
+
+    for (auto &column : _paintColumns)
+    {
+        // Generate the column again if the scrolling text cache can grow to hold all of its texts
+        for (;;)
+        {
+            scrolling_text_begin_frame();
+            column.Session = paint_session_alloc(&column.DPI);
+            viewport_fill_column(&column);
+            if (!scrolling_text_frame_overflowed())
+            {
+                break;
+            }
+            paint_session_free(column.Session);
+        }
+        viewport_paint_column(&column, viewFlags);
     }
 }
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+static void viewport_fill_column(paint_column * column)
 {
-    gCurrentViewportFlags = viewFlags;
+    paint_session_generate(column->Session);
+    column->PS = paint_session_arrange(column->Session);
+}
 
+static void viewport_paint_column(paint_column * column, uint32 viewFlags)
+{
+    rct_drawpixelinfo * dpi = &column->DPI;
     if (viewFlags & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE | VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT)) {
         uint8 colour = 10;
         if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) {
@@ -888,11 +973,7 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
         gfx_clear(dpi, colour);
     }
 
-    paint_session * session = paint_session_alloc(dpi);
-    paint_session_generate(session);
-    paint_struct ps = paint_session_arrange(session);
-    paint_draw_structs(dpi, &ps, viewFlags);
-    paint_session_free(session);
+    paint_draw_structs(dpi, &column->PS, viewFlags);
 
     if (gConfigGeneral.render_weather_gloom &&
         !gTrackDesignSaveMode &&
@@ -902,9 +983,14 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
         viewport_paint_weather_gloom(dpi);
     }
 
+    paint_session * session = column->Session;
     if (session->PSStringHead != nullptr) {
         paint_draw_money_structs(dpi, session->PSStringHead);
     }
+#ifdef __ENABLE_LIGHTFX__
+    lightfx_add_session_lights(session);
+#endif
+    paint_session_free(session);
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi)
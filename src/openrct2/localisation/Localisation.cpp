@@ -39,8 +39,8 @@
 #include "../ride/Ride.h"
 #include "../util/Util.h"
 
-char gCommonStringFormatBuffer[256];
-uint8 gCommonFormatArgs[80];
+thread_local char gCommonStringFormatBuffer[256];
+thread_local uint8 gCommonFormatArgs[80];
 uint8 gMapTooltipFormatArgs[40];
 
 #ifdef DEBUG
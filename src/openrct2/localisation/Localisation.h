@@ -81,8 +81,9 @@ extern const char real_name_initials[16];
 extern const char *real_names[1024];
 
 extern utf8 gUserStrings[MAX_USER_STRINGS][USER_STRING_MAX_LENGTH];
-extern char gCommonStringFormatBuffer[256];
-extern uint8 gCommonFormatArgs[80];
+// Per thread, as paint code formats banner and sign text from the paint job threads
+extern thread_local char gCommonStringFormatBuffer[256];
+extern thread_local uint8 gCommonFormatArgs[80];
 extern uint8 gMapTooltipFormatArgs[40];
 extern bool gDebugStringFormatting;
 
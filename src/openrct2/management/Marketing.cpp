@@ -146,6 +146,7 @@ void marketing_set_guest_campaign(rct_peep * peep, sint32 campaign)
         peep->peep_is_lost_countdown   = 240;
         break;
     }
+    park_rating_guest_changed(peep);
 }
 
 bool marketing_is_campaign_type_applicable(sint32 campaignType)
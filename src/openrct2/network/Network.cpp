@@ -34,7 +34,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "3"
+#define NETWORK_STREAM_VERSION "6"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static rct_peep* _pickup_peep = nullptr;
@@ -47,6 +47,7 @@ static sint32 _pickup_peep_old_x = LOCATION_NULL;
 #include <algorithm>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "../actions/GameAction.h"
 #include "../core/Console.hpp"
@@ -71,6 +72,7 @@ static sint32 _pickup_peep_old_x = LOCATION_NULL;
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../Cheats.h"
+#include "../world/MapAnimation.h"
 #include "../world/Park.h"
 
 #include "NetworkAction.h"
@@ -183,6 +185,7 @@ void Network::Close()
         CloseConnection();
 
         client_connection_list.clear();
+        _mapSnapshots.clear();
         game_command_queue.clear();
         player_list.clear();
         group_list.clear();
@@ -458,6 +461,8 @@ void Network::UpdateServer()
         }
     }
 
+    UpdateMapTransfers();
+
     uint32 ticks = platform_get_ticks();
     if (ticks > last_ping_sent_time + 3000) {
         Server_Send_PING();
@@ -671,6 +676,9 @@ bool Network::CheckSRAND(uint32 tick, uint32 srand0)
         const bool sprites_mismatch = server_sprite_hash[0] != '\0' && strcmp(client_sprite_hash, server_sprite_hash);
         // Check PRNG values and sprite hashes, if exist
         if ((srand0 != server_srand0) || sprites_mismatch) {
+            if (sprites_mismatch) {
+                LogSpriteRangeMismatches(tick);
+            }
 #ifdef DEBUG_DESYNC
             dbg_report_desync(tick, srand0, server_srand0, client_sprite_hash, server_sprite_hash);
 #endif
@@ -681,6 +689,24 @@ bool Network::CheckSRAND(uint32 tick, uint32 srand0)
     return true;
 }
 
+void Network::LogSpriteRangeMismatches(uint32 tick)
+{
+    const uint32 * clientRanges = sprite_checksum_ranges();
+    if (clientRanges == nullptr || server_sprite_ranges.size() != SPRITE_CHECKSUM_RANGE_COUNT)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < SPRITE_CHECKSUM_RANGE_COUNT; i++)
+    {
+        if (clientRanges[i] != server_sprite_ranges[i])
+        {
+            size_t first = i * SPRITE_CHECKSUM_RANGE_SIZE;
+            log_warning("Tick %u: sprites %u-%u differ from server", tick, (uint32)first, (uint32)(first + SPRITE_CHECKSUM_RANGE_SIZE - 1));
+        }
+    }
+}
+
 void Network::CheckDesynchronizaton()
 {
     // Check synchronisation
@@ -1108,76 +1134,85 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
         // TODO: fix it so custom objects negotiation is performed even in this case.
         IObjectManager * objManager = GetObjectManager();
         objects = objManager->GetPackableObjects();
+
+        // The park has been replaced without a game command, earlier snapshots are stale
+        _mapSnapshots.clear();
     }
 
-    size_t out_size;
-    uint8 * header = save_for_network(out_size, objects);
-    if (header == nullptr) {
+    auto snapshot = GetMapSnapshot(objects);
+    if (snapshot == nullptr) {
         if (connection) {
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
             connection->Socket->Disconnect();
         }
         return;
     }
-    size_t chunksize = 65000;
-    for (size_t i = 0; i < out_size; i += chunksize) {
-        size_t datasize = Math::Min(chunksize, out_size - i);
-        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-        *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)out_size << (uint32)i;
-        packet->Write(&header[i], datasize);
-        if (connection) {
-            connection->QueuePacket(std::move(packet));
-        } else {
-            SendPacketToClients(*packet);
+
+    // The map is queued by UpdateMapTransfers once it has been compressed
+    if (connection) {
+        connection->MapSnapshot = snapshot;
+    } else {
+        for (auto &client_connection : client_connection_list) {
+            if (client_connection->AuthStatus == NETWORK_AUTH_OK) {
+                client_connection->MapSnapshot = snapshot;
+            }
         }
     }
-    free(header);
 }
 
-uint8 * Network::save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const
+std::shared_ptr<NetworkMapSnapshot> Network::GetMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects)
 {
-    uint8 * header = nullptr;
-    out_size = 0;
+    // Snapshots can be shared until the game state changes, which is at the latest on the next tick
+    _mapSnapshots.erase(std::remove_if(_mapSnapshots.begin(), _mapSnapshots.end(),
+        [](const std::shared_ptr<NetworkMapSnapshot> &snapshot) { return snapshot->GetTick() != gCurrentTicks; }),
+        _mapSnapshots.end());
+    for (const auto &snapshot : _mapSnapshots) {
+        if (snapshot->GetObjects() == objects) {
+            log_verbose("Sharing map snapshot of tick %u", gCurrentTicks);
+            return snapshot;
+        }
+    }
+
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
     auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects)) {
+    bool saved = SaveMap(&ms, objects);
+    gUseRLE = RLEState;
+    if (!saved) {
         log_warning("Failed to export map.");
         return nullptr;
     }
-    gUseRLE = RLEState;
 
-    const void * data = ms.GetData();
-    sint32 size = ms.GetLength();
+    auto snapshot = NetworkMapSnapshot::Create(gCurrentTicks, objects, ms.GetData(), ms.GetLength());
+    _mapSnapshots.push_back(snapshot);
+    return snapshot;
+}
 
-    uint8 *compressed = util_zlib_deflate((const uint8 *)data, size, &out_size);
-    if (compressed != nullptr)
-    {
-        header = (uint8 *)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char *)header) + 1; // account for null terminator
-        header = (uint8 *)realloc(header, header_len + out_size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        } else {
-            memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
+void Network::UpdateMapTransfers()
+{
+    for (auto &connection : client_connection_list) {
+        auto snapshot = connection->MapSnapshot;
+        if (snapshot == nullptr || !snapshot->IsReady()) {
+            continue;
         }
-        free(compressed);
-    } else {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8 *)malloc(size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", size);
-        } else {
-            out_size = size;
-            memcpy(header, data, size);
+
+        const std::vector<uint8> &data = snapshot->GetData();
+        size_t chunksize = 65000;
+        for (size_t i = 0; i < data.size(); i += chunksize) {
+            size_t datasize = Math::Min(chunksize, data.size() - i);
+            std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+            *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)data.size() << (uint32)i;
+            packet->Write(&data[i], datasize);
+            connection->QueuePacket(std::move(packet));
         }
+
+        connection->MapSnapshot = nullptr;
+        connection->ReleaseHeldPackets();
     }
-    return header;
 }
 
+
 void Network::Client_Send_CHAT(const char* text)
 {
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
@@ -1208,6 +1243,9 @@ void Network::Server_Send_GAMECMD(uint32 eax, uint32 ebx, uint32 ecx, uint32 edx
     *packet << (uint32)NETWORK_COMMAND_GAMECMD << gCurrentTicks << eax << (ebx | GAME_COMMAND_FLAG_NETWORKED)
             << ecx << edx << esi << edi << ebp << playerid << callback;
     SendPacketToClients(*packet, false, true);
+
+    // Joining clients receive the command, a snapshot taken before it can not be shared with later ones
+    _mapSnapshots.clear();
 }
 
 void Network::Client_Send_GAME_ACTION(const GameAction *action)
@@ -1242,6 +1280,7 @@ void Network::Server_Send_GAME_ACTION(const GameAction *action)
     *packet << (uint32)NETWORK_COMMAND_GAME_ACTION << gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
+    _mapSnapshots.clear();
 }
 
 void Network::Server_Send_TICK()
@@ -1258,11 +1297,10 @@ void Network::Server_Send_TICK()
     *packet << (uint32)NETWORK_COMMAND_TICK << gCurrentTicks << gScenarioSrand0;
     uint32 flags = 0;
     // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
+    // The checksum itself is cheap, this mainly limits the bandwidth used by the range hashes.
     static sint32 checksum_counter = 0;
     checksum_counter++;
-    if (checksum_counter >= 100) {
+    if (checksum_counter >= 10) {
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
     }
@@ -1271,6 +1309,12 @@ void Network::Server_Send_TICK()
     *packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS) {
         packet->WriteString(sprite_checksum());
+
+        const uint32 * ranges = sprite_checksum_ranges();
+        *packet << (uint16)SPRITE_CHECKSUM_RANGE_COUNT;
+        for (size_t i = 0; i < SPRITE_CHECKSUM_RANGE_COUNT; i++) {
+            *packet << ranges[i];
+        }
     }
     SendPacketToClients(*packet);
 }
@@ -1982,7 +2026,7 @@ void Network::Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& pa
     uint32 size, offset;
     packet >> size >> offset;
     sint32 chunksize = (sint32)(packet.Size - packet.BytesRead);
-    if (chunksize <= 0) {
+    if (chunksize <= 0 || offset > size || (uint32)chunksize > size - offset) {
         return;
     }
     if (size > chunk_buffer.size()) {
@@ -2069,6 +2113,7 @@ bool Network::LoadMap(IStream * stream)
 
         // Read other data not in normal save files
         stream->Read(gSpriteSpatialIndex, 0x10001 * sizeof(uint16));
+        reset_peep_spatial_index();
         gGamePaused = stream->ReadValue<uint32>();
         _guestGenerationProbability = stream->ReadValue<uint32>();
         _suggestedGuestMaximum = stream->ReadValue<uint32>();
@@ -2094,6 +2139,15 @@ bool Network::LoadMap(IStream * stream)
         gConfigGeneral.show_real_names_of_guests = stream->ReadValue<uint8>() != 0;
         gCheatsIgnoreResearchStatus = stream->ReadValue<uint8>() != 0;
 
+        // Replaces the animations of the saved game, which may have been recreated from the map
+        uint32 numAnimations = stream->ReadValue<uint32>();
+        map_animation_clear();
+        for (uint32 i = 0; i < numAnimations; i++)
+        {
+            auto animation = stream->ReadValue<rct_map_animation>();
+            map_animation_create(animation.type, animation.x, animation.y, animation.baseZ);
+        }
+
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         result = true;
     }
@@ -2141,6 +2195,13 @@ bool Network::SaveMap(IStream * stream, const std::vector<const ObjectRepository
         stream->WriteValue<uint8>(gConfigGeneral.show_real_names_of_guests);
         stream->WriteValue<uint8>(gCheatsIgnoreResearchStatus);
 
+        // Saved games only have room for RCT2_MAX_ANIMATED_OBJECTS map animations. Doors and
+        // on-ride photos change the map, so clients need the exact same animations.
+        std::vector<rct_map_animation> animations(map_animation_get_count());
+        map_animation_get_all(animations.data(), animations.size());
+        stream->WriteValue<uint32>((uint32)animations.size());
+        stream->WriteArray(animations.data(), animations.size());
+
         result = true;
     }
     catch (const std::exception &)
@@ -2368,6 +2429,7 @@ void Network::Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& p
         server_srand0 = srand0;
         server_srand0_tick = server_tick;
         server_sprite_hash[0] = '\0';
+        server_sprite_ranges.clear();
         if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
         {
             const char* text = packet.ReadString();
@@ -2375,6 +2437,15 @@ void Network::Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& p
             {
                 safe_strcpy(server_sprite_hash, text, sizeof(server_sprite_hash));
             }
+
+            uint16 numRanges = 0;
+            packet >> numRanges;
+            for (uint16 i = 0; i < numRanges; i++)
+            {
+                uint32 rangeHash = 0;
+                packet >> rangeHash;
+                server_sprite_ranges.push_back(rangeHash);
+            }
         }
     }
     game_commands_processed_this_tick = 0;
@@ -58,7 +58,7 @@ sint32 NetworkConnection::ReadPacket()
             {
                 return NETWORK_READPACKET_DISCONNECTED;
             }
-            InboundPacket.Data->resize(InboundPacket.Size);
+            InboundPacket.Data->resize(sizeof(InboundPacket.Size) + InboundPacket.Size);
         }
     }
     else
@@ -88,12 +88,8 @@ sint32 NetworkConnection::ReadPacket()
 
 bool NetworkConnection::SendPacket(NetworkPacket& packet)
 {
-    uint16 sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), (uint8*)&sizen, (uint8*)&sizen + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
-
+    // The buffer already starts with the packet size
+    const std::vector<uint8> &tosend = *packet.Data;
     const void * buffer = &tosend[packet.BytesTransferred];
     size_t bufferSize = tosend.size() - packet.BytesTransferred;
     size_t sent = Socket->SendData(buffer, bufferSize);
@@ -108,8 +104,20 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
 {
     if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
     {
-        packet->Size = (uint16)packet->Data->size();
-        if (front)
+        packet->WriteSize();
+        if (MapSnapshot != nullptr && packet->GetCommand() != NETWORK_COMMAND_MAP)
+        {
+            // Packets have to reach the client after the map, hold them until the map has been queued
+            if (front)
+            {
+                _heldPackets.push_front(std::move(packet));
+            }
+            else
+            {
+                _heldPackets.push_back(std::move(packet));
+            }
+        }
+        else if (front)
         {
             // If the first packet was already partially sent add new packet to second position
             if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
@@ -130,6 +138,11 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
     }
 }
 
+void NetworkConnection::ReleaseHeldPackets()
+{
+    _outboundPackets.splice(_outboundPackets.end(), _heldPackets);
+}
+
 void NetworkConnection::SendQueuedPackets()
 {
     while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
@@ -25,6 +25,7 @@
 
 #include "NetworkTypes.h"
 #include "NetworkKey.h"
+#include "NetworkMapSnapshot.h"
 #include "NetworkPacket.h"
 
 interface ITcpSocket;
@@ -42,12 +43,15 @@ public:
     NetworkKey                                  Key;
     std::vector<uint8>                          Challenge;
     std::vector<const ObjectRepositoryItem *>   RequestedObjects;
+    // Map being prepared for this connection, all other packets are held back until it has been queued
+    std::shared_ptr<NetworkMapSnapshot>         MapSnapshot;
 
     NetworkConnection();
     ~NetworkConnection();
 
     sint32  ReadPacket();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    void ReleaseHeldPackets();
     void SendQueuedPackets();
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
@@ -58,6 +62,7 @@ public:
 
 private:
     std::list<std::unique_ptr<NetworkPacket>>   _outboundPackets;
+    std::list<std::unique_ptr<NetworkPacket>>   _heldPackets;
     uint32                                      _lastPacketTime;
     utf8 *                                      _lastDisconnectReason   = nullptr;
 
@@ -0,0 +1,108 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include <cstring>
+#include <zlib.h>
+#include "../core/Math.hpp"
+#include "NetworkMapSnapshot.h"
+
+// Same header as the one Client_Handle_MAP expects in front of compressed maps
+constexpr char MAP_ZLIB_HEADER[] = "open2_sv6_zlib";
+constexpr size_t MAP_COMPRESS_CHUNK_SIZE = 64 * 1024;
+
+NetworkMapSnapshot::NetworkMapSnapshot(uint32 tick, const std::vector<const ObjectRepositoryItem *> &objects, const void * data, size_t dataSize)
+    : _tick(tick),
+      _objects(objects),
+      _uncompressed((const uint8 *)data, (const uint8 *)data + dataSize)
+{
+}
+
+NetworkMapSnapshot::~NetworkMapSnapshot()
+{
+    if (_worker.joinable())
+    {
+        _worker.join();
+    }
+}
+
+std::shared_ptr<NetworkMapSnapshot> NetworkMapSnapshot::Create(uint32 tick, const std::vector<const ObjectRepositoryItem *> &objects, const void * data, size_t dataSize)
+{
+    auto snapshot = std::make_shared<NetworkMapSnapshot>(tick, objects, data, dataSize);
+    NetworkMapSnapshot * compressing = snapshot.get();
+    snapshot->_worker = std::thread([compressing]() -> void
+    {
+        compressing->Compress();
+    });
+    return snapshot;
+}
+
+void NetworkMapSnapshot::Compress()
+{
+    _data.assign(MAP_ZLIB_HEADER, MAP_ZLIB_HEADER + sizeof(MAP_ZLIB_HEADER));
+
+    // Deflate in slices so the output buffer only grows by what has actually been produced
+    z_stream strm = {};
+    bool success = deflateInit(&strm, Z_DEFAULT_COMPRESSION) == Z_OK;
+    if (success)
+    {
+        size_t inputOffset = 0;
+        sint32 ret;
+        do
+        {
+            size_t inputSize = Math::Min(MAP_COMPRESS_CHUNK_SIZE, _uncompressed.size() - inputOffset);
+            strm.next_in = _uncompressed.data() + inputOffset;
+            strm.avail_in = (uInt)inputSize;
+            inputOffset += inputSize;
+
+            sint32 flush = inputOffset == _uncompressed.size() ? Z_FINISH : Z_NO_FLUSH;
+            do
+            {
+                size_t outputOffset = _data.size();
+                _data.resize(outputOffset + MAP_COMPRESS_CHUNK_SIZE);
+                strm.next_out = _data.data() + outputOffset;
+                strm.avail_out = (uInt)MAP_COMPRESS_CHUNK_SIZE;
+                ret = deflate(&strm, flush);
+                _data.resize(_data.size() - strm.avail_out);
+            }
+            while (strm.avail_out == 0 && ret != Z_STREAM_ERROR);
+
+            // No progress is possible until more input is given
+            if (ret == Z_BUF_ERROR)
+            {
+                ret = Z_OK;
+            }
+        }
+        while (ret == Z_OK);
+        success = ret == Z_STREAM_END;
+        deflateEnd(&strm);
+    }
+
+    if (success)
+    {
+        log_verbose("Compressed map of size %zu bytes to %zu bytes", _uncompressed.size(), _data.size());
+    }
+    else
+    {
+        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
+        _data = _uncompressed;
+    }
+    _uncompressed = std::vector<uint8>();
+    _ready = true;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,70 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../common.h"
+
+struct ObjectRepositoryItem;
+
+/**
+ * A saved park that is sent to joining clients. The park is serialised on the game thread and then
+ * compressed on a worker thread, so the server keeps running while the map is being prepared.
+ * Clients that join during the same tick share a single snapshot.
+ *
+ * The worker thread is owned by the snapshot and joined when it is destroyed, so closing the server or
+ * dropping a client waits for a compression that is still running.
+ */
+class NetworkMapSnapshot final
+{
+private:
+    uint32                                      _tick;
+    std::vector<const ObjectRepositoryItem *>   _objects;
+    std::vector<uint8>                          _uncompressed;
+    std::vector<uint8>                          _data;
+    std::atomic_bool                            _ready  = { false };
+    std::thread                                 _worker;
+
+public:
+    /**
+     * Copies the serialised park and starts compressing it on a worker thread.
+     */
+    static std::shared_ptr<NetworkMapSnapshot> Create(uint32 tick, const std::vector<const ObjectRepositoryItem *> &objects, const void * data, size_t dataSize);
+
+    NetworkMapSnapshot(uint32 tick, const std::vector<const ObjectRepositoryItem *> &objects, const void * data, size_t dataSize);
+    ~NetworkMapSnapshot();
+
+    uint32 GetTick() const { return _tick; }
+    const std::vector<const ObjectRepositoryItem *> & GetObjects() const { return _objects; }
+
+    /**
+     * Whether the compression has finished, the data must not be accessed before.
+     */
+    bool IsReady() const { return _ready; }
+    const std::vector<uint8> & GetData() const { return _data; }
+
+private:
+    void Compress();
+};
+
+#endif // DISABLE_NETWORK
@@ -16,9 +16,22 @@
 
 #ifndef DISABLE_NETWORK
 
+#include <algorithm>
+#include <cstring>
 #include "NetworkTypes.h"
 #include "NetworkPacket.h"
 
+constexpr size_t BUFFER_POOL_MAX_SIZE = 256;
+constexpr size_t BUFFER_POOL_SEARCH_LENGTH = 8;
+constexpr size_t BUFFER_INITIAL_CAPACITY = 256;
+// Larger buffers, e.g. from map chunks, are given back to the allocator when reused
+constexpr size_t BUFFER_MAX_POOLED_CAPACITY = 4096;
+
+// Packets are only created on the game thread, so the pool is not locked. A pooled buffer is free
+// again once the pool holds the only reference to it.
+static std::vector<std::shared_ptr<std::vector<uint8>>> _bufferPool;
+static size_t _bufferPoolCursor = 0;
+
 std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
 {
     return std::unique_ptr<NetworkPacket>(new NetworkPacket); // change to make_unique in c++14
@@ -26,19 +39,52 @@ std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
 
 std::unique_ptr<NetworkPacket> NetworkPacket::Duplicate(NetworkPacket &packet)
 {
+    // Shares the buffer, only the transfer state is per packet
     return std::unique_ptr<NetworkPacket>(new NetworkPacket(packet)); // change to make_unique in c++14
 }
 
+std::shared_ptr<std::vector<uint8>> NetworkPacket::AllocateBuffer()
+{
+    // Packets are usually released in the order they were allocated, so the buffers after the
+    // last one handed out are the most likely to be free
+    size_t searchLength = std::min(BUFFER_POOL_SEARCH_LENGTH, _bufferPool.size());
+    for (size_t i = 0; i < searchLength; i++)
+    {
+        _bufferPoolCursor = (_bufferPoolCursor + 1) % _bufferPool.size();
+        auto &buffer = _bufferPool[_bufferPoolCursor];
+        if (buffer.use_count() == 1)
+        {
+            if (buffer->capacity() > BUFFER_MAX_POOLED_CAPACITY)
+            {
+                std::vector<uint8>().swap(*buffer);
+                buffer->reserve(BUFFER_INITIAL_CAPACITY);
+            }
+            buffer->assign(sizeof(Size), 0);
+            return buffer;
+        }
+    }
+
+    auto buffer = std::make_shared<std::vector<uint8>>();
+    buffer->reserve(BUFFER_INITIAL_CAPACITY);
+    buffer->assign(sizeof(Size), 0);
+    if (_bufferPool.size() < BUFFER_POOL_MAX_SIZE)
+    {
+        _bufferPool.push_back(buffer);
+        _bufferPoolCursor = _bufferPool.size() - 1;
+    }
+    return buffer;
+}
+
 uint8 * NetworkPacket::GetData()
 {
-    return &(*Data)[0];
+    return Data->data() + sizeof(Size);
 }
 
 uint32 NetworkPacket::GetCommand()
 {
-    if (Data->size() >= sizeof(uint32))
+    if (GetPayloadSize() >= sizeof(uint32))
     {
-        return ByteSwapBE(*(uint32 *)(&(*Data)[0]));
+        return ByteSwapBE(*(uint32 *)GetData());
     }
     else
     {
@@ -46,11 +92,23 @@ uint32 NetworkPacket::GetCommand()
     }
 }
 
+size_t NetworkPacket::GetPayloadSize() const
+{
+    return Data->size() - sizeof(Size);
+}
+
 void NetworkPacket::Clear()
 {
     BytesTransferred = 0;
     BytesRead = 0;
-    Data->clear();
+    Data->resize(sizeof(Size));
+}
+
+void NetworkPacket::WriteSize()
+{
+    Size = (uint16)GetPayloadSize();
+    uint16 sizen = ByteSwapBE(Size);
+    std::memcpy(Data->data(), &sizen, sizeof(sizen));
 }
 
 bool NetworkPacket::CommandRequiresAuth()
@@ -22,21 +22,30 @@
 #include "../core/DataSerialiser.h"
 #include "../common.h"
 
+/**
+ * A packet as it is sent over the socket: Data starts with the big endian payload size followed by
+ * the payload, so queued packets can be sent without being copied. Buffers are taken from a pool and
+ * reused once no packet refers to them anymore. Duplicated packets share the buffer of the original,
+ * which must not be modified once it has been queued.
+ */
 class NetworkPacket final
 {
 public:
     uint16                              Size = 0;
-    std::shared_ptr<std::vector<uint8>> Data = std::make_shared<std::vector<uint8>>();
+    std::shared_ptr<std::vector<uint8>> Data = AllocateBuffer();
     size_t                              BytesTransferred = 0;
     size_t                              BytesRead = 0;
 
     static std::unique_ptr<NetworkPacket> Allocate();
     static std::unique_ptr<NetworkPacket> Duplicate(NetworkPacket& packet);
+    static std::shared_ptr<std::vector<uint8>> AllocateBuffer();
 
     uint8 * GetData();
     uint32  GetCommand();
+    size_t  GetPayloadSize() const;
 
     void Clear();
+    void WriteSize();
     bool CommandRequiresAuth();
 
     const uint8 * Read(size_t size);
@@ -110,6 +110,7 @@ public:
     static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
     void SendPacketToClients(NetworkPacket& packet, bool front = false, bool gameCmd = false);
     bool CheckSRAND(uint32 tick, uint32 srand0);
+    void LogSpriteRangeMismatches(uint32 tick);
     void CheckDesynchronizaton();
     void KickPlayer(sint32 playerId);
     void SetPassword(const char* password);
@@ -236,10 +237,12 @@ private:
     uint32 server_srand0 = 0;
     uint32 server_srand0_tick = 0;
     char server_sprite_hash[EVP_MAX_MD_SIZE + 1];
+    std::vector<uint32> server_sprite_ranges;
     uint8 player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::multiset<GameCommand> game_command_queue;
     std::vector<uint8> chunk_buffer;
+    std::vector<std::shared_ptr<NetworkMapSnapshot>> _mapSnapshots;
     std::string _password;
     bool _desynchronised = false;
     INetworkServerAdvertiser * _advertiser = nullptr;
@@ -256,6 +259,7 @@ private:
 
     void UpdateServer();
     void UpdateClient();
+    void UpdateMapTransfers();
 
 private:
     std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> client_command_handlers;
@@ -286,7 +290,7 @@ private:
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8 * save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const;
+    std::shared_ptr<NetworkMapSnapshot> GetMapSnapshot(const std::vector<const ObjectRepositoryItem *> &objects);
 
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
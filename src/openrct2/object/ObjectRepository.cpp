@@ -96,6 +96,10 @@ public:
     }
 
 public:
+    /**
+     * Runs on the indexing worker threads. The object is only read, not loaded, so no images or
+     * language strings are allocated; errors are logged by ObjectFactory with the file path.
+     */
     std::tuple<bool, ObjectRepositoryItem> Create(const std::string &path) const override
     {
         auto object = ObjectFactory::CreateObjectFromLegacyFile(path.c_str());
@@ -328,7 +332,7 @@ public:
         }
     }
 
-    void WritePackedObjects(IStream * stream, std::vector<const ObjectRepositoryItem *> &objects) override
+    void WritePackedObjects(SawyerChunkWriter &writer, std::vector<const ObjectRepositoryItem *> &objects) override
     {
         log_verbose("packing %u objects", objects.size());
         for (const auto &object : objects)
@@ -338,7 +342,7 @@ public:
             log_verbose("exporting object %.8s", object->ObjectEntry.name);
             if (IsObjectCustom(object))
             {
-                WritePackedObject(stream, &object->ObjectEntry);
+                WritePackedObject(writer, &object->ObjectEntry);
             }
             else
             {
@@ -586,7 +590,7 @@ private:
         }
     }
 
-    void WritePackedObject(IStream * stream, const rct_object_entry * entry)
+    void WritePackedObject(SawyerChunkWriter &writer, const rct_object_entry * entry)
     {
         const ObjectRepositoryItem * item = FindObject(entry);
         if (item == nullptr)
@@ -605,9 +609,8 @@ private:
         auto chunk = chunkReader.ReadChunk();
 
         // Write object data to stream
-        auto chunkWriter = SawyerChunkWriter(stream);
-        stream->WriteValue(*entry);
-        chunkWriter.WriteChunk(chunk.get());
+        writer.WriteValue(*entry);
+        writer.WriteChunk(chunk.get());
     }
 };
 
@@ -23,6 +23,7 @@
 
 interface   IStream;
 class       Object;
+class       SawyerChunkWriter;
 namespace OpenRCT2
 {
     interface IPlatformEnvironment;
@@ -74,7 +75,7 @@ interface IObjectRepository
                                                       size_t dataSize) abstract;
 
     virtual void                            ExportPackedObject(IStream * stream) abstract;
-    virtual void                            WritePackedObjects(IStream * stream, std::vector<const ObjectRepositoryItem *> &objects) abstract;
+    virtual void                            WritePackedObjects(SawyerChunkWriter &writer, std::vector<const ObjectRepositoryItem *> &objects) abstract;
 };
 
 IObjectRepository * CreateObjectRepository(OpenRCT2::IPlatformEnvironment * env);
@@ -15,6 +15,8 @@
 #pragma endregion
 
 #include <algorithm>
+#include <mutex>
+#include <vector>
 #include "../config/Config.h"
 #include "../core/Math.hpp"
 #include "../drawing/Drawing.h"
@@ -28,7 +30,12 @@
 uint8 gClipHeight = 128; // Default to middle value
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+
+// Sessions and their arenas are large, so released ones are kept around for the next column
+static std::vector<paint_session *> _allPaintSessions;
+static std::vector<paint_session *> _freePaintSessions;
+static paint_arena_stats _paintArenaStats;
+static std::mutex _paintSessionsMutex;
 
 static constexpr const uint8 BoundBoxDebugColours[] =
 {
@@ -51,16 +58,37 @@ bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
 
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi);
+static bool paint_session_grow(paint_session * session);
 static void paint_attached_ps(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
 static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static void paint_ps_image(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32 viewFlags);
 
+static void paint_arena_reset(paint_arena * arena)
+{
+    if (arena->first == nullptr)
+    {
+        arena->first = new paint_arena_chunk;
+        arena->first->next = nullptr;
+        arena->chunk_count = 1;
+    }
+    arena->current = arena->first;
+    arena->full_chunk_entries = 0;
+    arena->dropped_entries = 0;
+}
+
+static uint32 paint_session_get_used_entries(const paint_session * session)
+{
+    const paint_arena * arena = &session->Arena;
+    return arena->full_chunk_entries + (uint32)(session->NextFreePaintStruct - arena->current->entries);
+}
+
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
 {
     session->Unk140E9A8 = dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    paint_arena_reset(&session->Arena);
+    session->NextFreePaintStruct = session->Arena.current->entries;
+    session->EndOfPaintStructArray = session->Arena.current->entries + PAINT_ARENA_CHUNK_SIZE;
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
     for (auto &quadrant : session->Quadrants)
@@ -74,6 +102,7 @@ static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->Lights.clear();
 }
 
 static void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
@@ -87,13 +116,51 @@ static void paint_session_add_ps_to_quadrant(paint_session * session, paint_stru
     session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, paintQuadrantIndex);
 }
 
+/**
+ * Makes sure NextFreePaintStruct points at a usable entry, moving on to the next chunk of the
+ * arena when the current one is full.
+ */
+static bool paint_session_reserve_entry(paint_session * session)
+{
+    return session->NextFreePaintStruct < session->EndOfPaintStructArray || paint_session_grow(session);
+}
+
+static bool paint_session_grow(paint_session * session)
+{
+    paint_arena * arena = &session->Arena;
+    if (arena->current == nullptr)
+    {
+        // Not a pooled session (e.g. testpaint), keep the original fixed limit
+        return false;
+    }
+
+    if (arena->current->next == nullptr)
+    {
+        if (arena->chunk_count >= PAINT_ARENA_MAX_CHUNKS)
+        {
+            arena->dropped_entries++;
+            return false;
+        }
+        auto chunk = new paint_arena_chunk;
+        chunk->next = nullptr;
+        arena->current->next = chunk;
+        arena->chunk_count++;
+    }
+
+    arena->full_chunk_entries += PAINT_ARENA_CHUNK_SIZE;
+    arena->current = arena->current->next;
+    session->NextFreePaintStruct = arena->current->entries;
+    session->EndOfPaintStructArray = arena->current->entries + PAINT_ARENA_CHUNK_SIZE;
+    return true;
+}
+
 /**
 * Extracted from 0x0098196c, 0x0098197c, 0x0098198c, 0x0098199c
 */
 static paint_struct * sub_9819_c(
     paint_session * session, uint32 image_id, LocationXYZ16 offset, LocationXYZ16 boundBoxSize, LocationXYZ16 boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) return nullptr;
+    if (!paint_session_reserve_entry(session)) return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
@@ -718,10 +785,21 @@ static void draw_pixel_info_crop_by_zoom(rct_drawpixelinfo *dpi)
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 {
-    // Currently limited to just one session at a time
-    assert(!_paintSessionInUse);
-    _paintSessionInUse = true;
-    paint_session * session = &gPaintSession;
+    paint_session * session = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionsMutex);
+        if (!_freePaintSessions.empty())
+        {
+            session = _freePaintSessions.back();
+            _freePaintSessions.pop_back();
+        }
+    }
+    if (session == nullptr)
+    {
+        session = new paint_session();
+        std::lock_guard<std::mutex> lock(_paintSessionsMutex);
+        _allPaintSessions.push_back(session);
+    }
 
     paint_session_init(session, dpi);
     return session;
@@ -729,7 +807,28 @@ paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 
 void paint_session_free(paint_session * session)
 {
-    _paintSessionInUse = false;
+    uint32 usedEntries = paint_session_get_used_entries(session);
+
+    std::lock_guard<std::mutex> lock(_paintSessionsMutex);
+    _paintArenaStats.peak_entries = std::max(_paintArenaStats.peak_entries, usedEntries);
+    if (usedEntries > PAINT_ARENA_CHUNK_SIZE)
+    {
+        _paintArenaStats.grown_sessions++;
+    }
+    _paintArenaStats.dropped_entries += session->Arena.dropped_entries;
+    _freePaintSessions.push_back(session);
+}
+
+paint_arena_stats paint_get_arena_stats()
+{
+    std::lock_guard<std::mutex> lock(_paintSessionsMutex);
+    paint_arena_stats stats = _paintArenaStats;
+    stats.total_chunks = 0;
+    for (const auto session : _allPaintSessions)
+    {
+        stats.total_chunks += session->Arena.chunk_count;
+    }
+    return stats;
 }
 
 /**
@@ -760,7 +859,7 @@ paint_struct * sub_98196C(
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return nullptr;
     }
@@ -1072,7 +1171,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return false;
     }
@@ -1104,7 +1203,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 */
 bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return false;
     }
@@ -1145,7 +1244,7 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
 */
 void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return;
     }
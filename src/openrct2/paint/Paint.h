@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <vector>
 #include "../common.h"
 #include "../interface/Colour.h"
 #include "../drawing/Drawing.h"
@@ -132,10 +133,53 @@ struct tunnel_entry {
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT    65
 
+#define PAINT_ARENA_CHUNK_SIZE  4000
+#define PAINT_ARENA_MAX_CHUNKS  64
+
+struct paint_arena_chunk
+{
+    paint_arena_chunk *     next;
+    paint_entry             entries[PAINT_ARENA_CHUNK_SIZE];
+};
+
+/**
+ * Backing store for the paint entries of a session. Chunks are never freed or moved, so
+ * entries stay valid while the session grows; resetting only rewinds to the first chunk.
+ */
+struct paint_arena
+{
+    paint_arena_chunk *     first;
+    paint_arena_chunk *     current;
+    uint32                  chunk_count;
+    uint32                  full_chunk_entries;
+    uint32                  dropped_entries;
+};
+
+struct paint_arena_stats
+{
+    uint32  peak_entries;       // Most entries used by a single session
+    uint32  total_chunks;       // Chunks allocated across all pooled sessions
+    uint32  grown_sessions;     // Number of times a session needed more than one chunk
+    uint32  dropped_entries;    // Entries that could not be allocated at PAINT_ARENA_MAX_CHUNKS
+};
+
+/**
+ * A light found while generating a session, see lightfx_add_3d_light.
+ */
+struct paint_light
+{
+    uint32  light_id;
+    uint16  qualifier;
+    sint16  x;
+    sint16  y;
+    uint16  z;
+    uint8   type;
+};
+
 struct paint_session
 {
     rct_drawpixelinfo *      Unk140E9A8;
-    paint_entry              PaintStructs[4000];
+    paint_arena              Arena;
     paint_struct *           Quadrants[MAX_PAINT_QUADRANTS];
     uint32                   QuadrantBackIndex;
     uint32                   QuadrantFrontIndex;
@@ -166,6 +210,7 @@ struct paint_session
     uint8                    Unk141E9DB;
     uint16                   WaterHeight;
     uint32                   TrackColours[4];
+    std::vector<paint_light> Lights;
 };
 
 extern paint_session gPaintSession;
@@ -236,6 +281,7 @@ void paint_floating_money_effect(paint_session * session, money32 amount, rct_st
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi);
 void paint_session_free(paint_session *);
+paint_arena_stats paint_get_arena_stats();
 void paint_session_generate(paint_session * session);
 paint_struct paint_session_arrange(paint_session * session);
 paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation);
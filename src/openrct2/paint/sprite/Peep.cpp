@@ -54,7 +54,7 @@ void peep_paint(paint_session * session, rct_peep * peep, sint32 imageDirection)
                 return;
             };
 
-            lightfx_add_3d_light(peep->sprite_index, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, peep_x, peep_y, peep_z, LIGHTFX_LIGHT_TYPE_SPOT_1);
+            lightfx_add_3d_light(session, peep->sprite_index, 0x0000 | LIGHTFX_LIGHT_QUALIFIER_SPRITE, peep_x, peep_y, peep_z, LIGHTFX_LIGHT_TYPE_SPOT_1);
         }
     }
 #endif
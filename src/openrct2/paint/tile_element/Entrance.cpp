@@ -28,8 +28,6 @@
 #include "TileElement.h"
 #include "../../drawing/LightFX.h"
 
-static uint32 _unk9E32BC;
-
 /**
  *
  *  rct2: 0x0066508C, 0x00665540
@@ -47,21 +45,21 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
 #ifdef __ENABLE_LIGHTFX__
     if (lightfx_is_available()) {
         if (!is_exit) {
-            lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, 0, height + 45, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+            lightfx_add_3d_light_magic_from_drawing_tile(session, 0, 0, height + 45, LIGHTFX_LIGHT_TYPE_LANTERN_3);
         }
 
         switch (tile_element_get_direction(tile_element)) {
         case 0:
-            lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 16, 0, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
+            lightfx_add_3d_light_magic_from_drawing_tile(session, 16, 0, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
             break;
         case 1:
-            lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, -16, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
+            lightfx_add_3d_light_magic_from_drawing_tile(session, 0, -16, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
             break;
         case 2:
-            lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, -16, 0, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
+            lightfx_add_3d_light_magic_from_drawing_tile(session, -16, 0, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
             break;
         case 3:
-            lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, 16, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
+            lightfx_add_3d_light_magic_from_drawing_tile(session, 0, 16, height + 16, LIGHTFX_LIGHT_TYPE_LANTERN_2);
             break;
         };
     }
@@ -84,12 +82,12 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
     image_id = (colour_1 << 19) | (colour_2 << 24) | IMAGE_TYPE_REMAP | IMAGE_TYPE_REMAP_2_PLUS;
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_RIDE;
-    _unk9E32BC = 0;
+    uint32 ghostImageId = 0;
 
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         image_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = image_id;
+        ghostImageId = image_id;
         if (transparant_image_id)
             transparant_image_id = image_id;
     }
@@ -177,7 +175,7 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
             height + style->height, 2, 2, height + style->height);
     }
 
-    image_id = _unk9E32BC;
+    image_id = ghostImageId;
     if (image_id == 0) {
         image_id = SPRITE_ID_PALETTE_COLOUR_1(COLOUR_SATURATED_BROWN);
     }
@@ -200,17 +198,15 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
 
 #ifdef __ENABLE_LIGHTFX__
     if (lightfx_is_available()) {
-        lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, 0, 155, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+        lightfx_add_3d_light_magic_from_drawing_tile(session, 0, 0, 155, LIGHTFX_LIGHT_TYPE_LANTERN_3);
     }
 #endif
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_PARK;
-    _unk9E32BC = 0;
     uint32 image_id, ghost_id = 0;
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         ghost_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = ghost_id;
     }
 
     // Index to which part of the entrance
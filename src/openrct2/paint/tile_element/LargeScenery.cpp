@@ -100,7 +100,7 @@ static sint32 large_scenery_sign_text_height(const utf8 *str, rct_large_scenery_
 
 static const utf8 *large_scenery_sign_fit_text(const utf8 *str, rct_large_scenery_text *text, bool height)
 {
-    static utf8 fitStr[32];
+    static thread_local utf8 fitStr[32];
     utf8 *fitStrEnd = fitStr;
     safe_strcpy(fitStr, str, sizeof(fitStr));
     sint32 w = 0;
@@ -882,16 +882,16 @@ void path_paint(paint_session * session, uint8 direction, uint16 height, const r
             rct_scenery_entry *sceneryEntry = get_footpath_item_entry(footpath_element_get_path_scenery_index(tile_element));
             if (sceneryEntry->path_bit.flags & PATH_BIT_FLAG_LAMP) {
                 if (!(tile_element->properties.path.edges & EDGE_NE)) {
-                    lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, -16, 0, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_3d_light_magic_from_drawing_tile(session, -16, 0, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 if (!(tile_element->properties.path.edges & EDGE_SE)) {
-                    lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, 16, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_3d_light_magic_from_drawing_tile(session, 0, 16, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 if (!(tile_element->properties.path.edges & EDGE_SW)) {
-                    lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 16, 0, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_3d_light_magic_from_drawing_tile(session, 16, 0, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
                 if (!(tile_element->properties.path.edges & EDGE_NW)) {
-                    lightfx_add_3d_light_magic_from_drawing_tile(session->MapPosition, 0, -16, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
+                    lightfx_add_3d_light_magic_from_drawing_tile(session, 0, -16, height + 23, LIGHTFX_LIGHT_TYPE_LANTERN_3);
                 }
             }
         }
@@ -27,6 +27,7 @@
 #include "../core/Util.hpp"
 #include "../Game.h"
 #include "../Input.h"
+#include "../interface/Viewport.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -674,18 +675,7 @@ static uint8 peep_assess_surroundings(sint16 centre_x, sint16 centre_y, sint16 c
         }
     }
 
-    rct_litter * litter;
-    for (uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next)
-    {
-        litter = &(get_sprite(sprite_idx)->litter);
-
-        sint16 dist_x = abs(litter->x - centre_x);
-        sint16 dist_y = abs(litter->y - centre_y);
-        if (Math::Max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
-    }
+    num_rubbish = litter_count_in_range(centre_x, centre_y, 160);
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -737,6 +727,7 @@ static void peep_leave_park(rct_peep * peep)
         peep->peep_is_lost_countdown = 254;
         peep->peep_flags |= PEEP_FLAGS_LEAVING_PARK;
         peep->peep_flags &= ~PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
+        park_rating_guest_changed(peep);
     }
 
     peep_insert_new_thought(peep, PEEP_THOUGHT_TYPE_GO_HOME, PEEP_THOUGHT_ITEM_NONE);
@@ -1442,6 +1433,7 @@ static void sub_68F41A(rct_peep * peep, sint32 index)
     {
         peep->happiness = happiness;
         peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_2;
+        park_rating_guest_changed(peep);
     }
 
     uint8 nausea        = peep->nausea;
@@ -1638,6 +1630,7 @@ static void peep_check_cant_find_ride(rct_peep * peep)
     }
 
     peep->peep_is_lost_countdown--;
+    park_rating_guest_changed(peep);
     if (peep->peep_is_lost_countdown != 0)
         return;
 
@@ -1671,6 +1664,7 @@ static void peep_check_cant_find_exit(rct_peep * peep)
 
     if (--peep->peep_is_lost_countdown == 0)
         peep->peep_is_lost_countdown = 90;
+    park_rating_guest_changed(peep);
 }
 
 /** rct2: 0x00981D7C, 0x00981D7E */
@@ -2238,6 +2232,7 @@ void peep_sprite_remove(rct_peep * peep)
         window_invalidate_by_class(WC_STAFF_LIST);
 
         gStaffModes[peep->staff_id] = 0;
+        staff_remove_from_patrol_index(peep);
         peep->type                  = 0xFF;
         staff_update_greyed_patrol_areas();
         peep->type = PEEP_TYPE_STAFF;
@@ -5845,6 +5840,7 @@ static void peep_update_leaving_park(rct_peep * peep)
 
     peep->outside_of_park       = 1;
     peep->destination_tolerance = 5;
+    park_rating_guest_changed(peep);
     decrement_guests_in_park();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     context_broadcast_intent(&intent);
@@ -5989,6 +5985,7 @@ static void peep_update_entering_park(rct_peep * peep)
 
     peep->outside_of_park = 0;
     peep->time_in_park    = gScenarioTicks;
+    park_rating_guest_changed(peep);
     increment_guests_in_park();
     decrement_guests_heading_for_park();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
@@ -6262,12 +6259,13 @@ static void peep_update_walking_break_scenery(rct_peep * peep)
         return;
     }
 
-    rct_peep * inner_peep;
-    uint16     sprite_index;
+    static std::vector<uint16> nearbyPeeps;
+    peep_spatial_index_query(peep->x, peep->y, 223, nearbyPeeps);
 
-    FOR_ALL_STAFF(sprite_index, inner_peep)
+    for (uint16 sprite_index : nearbyPeeps)
     {
-        if (inner_peep->staff_type != STAFF_TYPE_SECURITY)
+        rct_peep * inner_peep = GET_PEEP(sprite_index);
+        if (inner_peep->type != PEEP_TYPE_STAFF || inner_peep->staff_type != STAFF_TYPE_SECURITY)
             continue;
 
         if (inner_peep->x == LOCATION_NULL)
@@ -7811,7 +7809,6 @@ void peep_stop_crowd_noise()
 void peep_update_crowd_noise()
 {
     rct_viewport * viewport;
-    uint16         spriteIndex;
     rct_peep *     peep;
     sint32         visiblePeeps;
 
@@ -7828,11 +7825,32 @@ void peep_update_crowd_noise()
     if (viewport == nullptr)
         return;
 
+    // Only peeps standing in the map area behind the viewport can be visible. Sprite bounds extend at most 255
+    // pixels from the sprite position and sprites are at most 255 land heights up.
+    sint32 mapLeft = INT32_MAX, mapTop = INT32_MAX, mapRight = INT32_MIN, mapBottom = INT32_MIN;
+    for (sint32 corner = 0; corner < 8; corner++)
+    {
+        sint32 screenX = (corner & 1) ? viewport->view_x + viewport->view_width + 255 : viewport->view_x - 255;
+        sint32 screenY = (corner & 2) ? viewport->view_y + viewport->view_height + 255 : viewport->view_y - 255;
+        sint32 z = (corner & 4) ? 255 * 8 : 0;
+        LocationXY16 mapCoord = viewport_coord_to_map_coord(screenX, screenY, z);
+        mapLeft = Math::Min<sint32>(mapLeft, mapCoord.x);
+        mapTop = Math::Min<sint32>(mapTop, mapCoord.y);
+        mapRight = Math::Max<sint32>(mapRight, mapCoord.x);
+        mapBottom = Math::Max<sint32>(mapBottom, mapCoord.y);
+    }
+
+    static std::vector<uint16> nearbyPeeps;
+    peep_spatial_index_query_rect(mapLeft, mapTop, mapRight, mapBottom, nearbyPeeps);
+
     // Count the number of peeps visible
     visiblePeeps = 0;
 
-    FOR_ALL_GUESTS(spriteIndex, peep)
+    for (uint16 spriteIndex : nearbyPeeps)
     {
+        peep = GET_PEEP(spriteIndex);
+        if (peep->type != PEEP_TYPE_GUEST)
+            continue;
         if (peep->sprite_left == LOCATION_NULL)
             continue;
         if (viewport->view_x > peep->sprite_right)
@@ -8195,6 +8213,7 @@ rct_peep * peep_generate(sint32 x, sint32 y, sint32 z)
     peep_update_name_sort(peep);
 
     increment_guests_heading_for_park();
+    park_rating_guest_changed(peep);
 
     return peep;
 }
@@ -9620,7 +9639,7 @@ static sint32 guest_surface_path_finding(rct_peep * peep)
     return peep_move_one_tile(randDirection, peep);
 }
 
-static rct_tile_element * get_banner_on_path(rct_tile_element * path_element)
+rct_tile_element * get_banner_on_path(rct_tile_element * path_element)
 {
     // This is an improved version of original.
     // That only checked for one fence in the way.
@@ -10820,8 +10839,21 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * pe
 
     sint32 chosen_edge = bitscanforward(edges);
 
+    /* Guests use the cached footpath graph which has no search limits,
+     * the heuristic search is only used when it can not reach the goal. */
+    sint32 graph_edge = -1;
+    if (peep->type == PEEP_TYPE_GUEST && (edges & ~(1 << chosen_edge)))
+    {
+        graph_edge = footpath_graph_choose_direction(x >> 5, y >> 5, z, edges, gPeepPathFindGoalPosition,
+                                                     gPeepPathFindQueueRideIndex, gPeepPathFindIgnoreForeignQueues);
+    }
+
+    if (graph_edge != -1)
+    {
+        chosen_edge = graph_edge;
+    }
     // Peep has multiple edges still to try.
-    if (edges & ~(1 << chosen_edge))
+    else if (edges & ~(1 << chosen_edge))
     {
         uint16 best_score = 0xFFFF;
         uint8  best_sub   = 0xFF;
@@ -12169,6 +12201,7 @@ static void peep_on_exit_ride(rct_peep * peep, sint32 rideIndex)
     {
         peep->guest_heading_to_ride_id = rideIndex;
         peep->peep_is_lost_countdown   = 200;
+        park_rating_guest_changed(peep);
         peep_reset_pathfind_goal(peep);
 
         rct_window * w = window_find_by_number(WC_PEEP, peep->sprite_index);
@@ -12371,6 +12404,7 @@ loc_69B119:
             sint32 happinessGrowth = value * 4;
             peep->happiness_target = Math::Min((peep->happiness_target + happinessGrowth), PEEP_MAX_HAPPINESS);
             peep->happiness        = Math::Min((peep->happiness + happinessGrowth), PEEP_MAX_HAPPINESS);
+            park_rating_guest_changed(peep);
         }
     }
 
@@ -13709,6 +13743,7 @@ static void peep_pick_ride_to_go_on(rct_peep * peep)
     // Head to that ride
     peep->guest_heading_to_ride_id = mostExcitingRideIndex;
     peep->peep_is_lost_countdown   = 200;
+    park_rating_guest_changed(peep);
     peep_reset_pathfind_goal(peep);
 
     // Invalidate windows
@@ -13839,6 +13874,7 @@ static void peep_head_for_nearest_ride_type(rct_peep * peep, sint32 rideType)
     // Head to that ride
     peep->guest_heading_to_ride_id = closestRideIndex;
     peep->peep_is_lost_countdown   = 200;
+    park_rating_guest_changed(peep);
     peep_reset_pathfind_goal(peep);
 
     // Invalidate windows
@@ -13971,6 +14007,7 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep * peep, sint32 rideTy
     // Head to that ride
     peep->guest_heading_to_ride_id = closestRideIndex;
     peep->peep_is_lost_countdown   = 200;
+    park_rating_guest_changed(peep);
     peep_reset_pathfind_goal(peep);
 
     // Invalidate windows
@@ -14366,6 +14403,8 @@ void peep_handle_easteregg_name(rct_peep * peep)
     {
         peep->peep_flags |= PEEP_FLAGS_HERE_WE_ARE;
     }
+
+    park_rating_guest_changed(peep);
 }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
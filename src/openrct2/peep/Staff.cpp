@@ -14,6 +14,9 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
+#include <bitset>
+#include <vector>
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../Context.h"
@@ -63,6 +66,14 @@ colour_t gStaffHandymanColour;
 colour_t gStaffMechanicColour;
 colour_t gStaffSecurityColour;
 
+// Reverse index of gStaffPatrolAreas so that mechanics can be found for a location without walking all peeps.
+// Each 4x4 patrol quad has the set of staff ids whose patrol area contains it, the other sets are indexed by staff id.
+using staff_id_set = std::bitset<STAFF_MAX_COUNT>;
+static staff_id_set _patrolQuadStaff[STAFF_PATROL_AREA_SIZE * 32];
+static staff_id_set _mechanicStaff;
+static staff_id_set _patrollingStaff;
+static uint16       _staffSpriteIndex[STAFF_MAX_COUNT];
+
 /**
  *
  *  rct2: 0x006BD3A4
@@ -76,6 +87,97 @@ void staff_reset_modes()
         gStaffModes[i] = STAFF_MODE_WALK;
 
     staff_update_greyed_patrol_areas();
+    staff_reset_patrol_index();
+}
+
+static sint32 staff_get_patrol_quad_index(sint32 x, sint32 y)
+{
+    return ((x & 0x1F80) >> 7) | ((y & 0x1F80) >> 1);
+}
+
+/**
+ * Rebuilds the patrol area reverse index from gStaffModes, gStaffPatrolAreas and the staff sprites. Must be called
+ * whenever these have been written to directly, e.g. after loading a park.
+ */
+void staff_reset_patrol_index()
+{
+    for (auto &quadStaff : _patrolQuadStaff)
+    {
+        quadStaff.reset();
+    }
+    for (sint32 staffIndex = 0; staffIndex < STAFF_MAX_COUNT; staffIndex++)
+    {
+        const uint32 * patrolArea = &gStaffPatrolAreas[staffIndex * STAFF_PATROL_AREA_SIZE];
+        for (sint32 i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
+        {
+            for (uint32 bits = patrolArea[i]; bits != 0; bits &= bits - 1)
+            {
+                _patrolQuadStaff[i * 32 + bitscanforward((sint32)bits)][staffIndex] = true;
+            }
+        }
+    }
+
+    _mechanicStaff.reset();
+    _patrollingStaff.reset();
+    std::fill_n(_staffSpriteIndex, STAFF_MAX_COUNT, SPRITE_INDEX_NULL);
+
+    uint16     spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_STAFF(spriteIndex, peep)
+    {
+        staff_update_patrol_index(peep);
+    }
+}
+
+/**
+ * Updates the patrol area reverse index after a staff member has been hired or its staff mode has changed.
+ */
+void staff_update_patrol_index(rct_peep * staff)
+{
+    sint32 staffIndex = staff->staff_id;
+    if (staffIndex >= STAFF_MAX_COUNT)
+        return;
+
+    _staffSpriteIndex[staffIndex] = staff->sprite_index;
+    _mechanicStaff[staffIndex]    = staff->staff_type == STAFF_TYPE_MECHANIC;
+    _patrollingStaff[staffIndex]  = (gStaffModes[staffIndex] & 2) != 0;
+}
+
+void staff_remove_from_patrol_index(rct_peep * staff)
+{
+    sint32 staffIndex = staff->staff_id;
+    if (staffIndex >= STAFF_MAX_COUNT)
+        return;
+
+    _staffSpriteIndex[staffIndex] = SPRITE_INDEX_NULL;
+    _mechanicStaff[staffIndex]    = false;
+    _patrollingStaff[staffIndex]  = false;
+}
+
+/**
+ * Gets the sprite indices of the mechanics that may work at the given location according to their patrol areas. Inside
+ * the park these are the mechanics patrolling the location and the mechanics without a patrol area, outside the park
+ * all mechanics. Callers still have to check staff_is_location_in_patrol.
+ * @param results receives the sprite indices in staff id order, has room for STAFF_MAX_COUNT.
+ * @returns the number of mechanics written to results.
+ */
+size_t staff_get_mechanics_for_location(sint32 x, sint32 y, uint16 * results)
+{
+    size_t count = 0;
+    staff_id_set candidates = _mechanicStaff;
+    if (map_is_location_in_park(x, y))
+    {
+        candidates &= _patrolQuadStaff[staff_get_patrol_quad_index(x, y)] | ~_patrollingStaff;
+    }
+
+    for (sint32 staffIndex = 0; staffIndex < STAFF_MAX_COUNT; staffIndex++)
+    {
+        if (candidates[staffIndex])
+        {
+            results[count++] = _staffSpriteIndex[staffIndex];
+        }
+    }
+    return count;
 }
 
 static inline void staff_autoposition_new_staff_member(rct_peep * newPeep)
@@ -345,6 +447,11 @@ static money32 staff_hire_new_staff_member(uint8 staff_type, uint8 flags, sint16
             {
                 gStaffPatrolAreas[newStaffId * STAFF_PATROL_AREA_SIZE + i] = 0;
             }
+            for (auto &quadStaff : _patrolQuadStaff)
+            {
+                quadStaff[newStaffId] = false;
+            }
+            staff_update_patrol_index(newPeep);
         }
 
         *newPeep_sprite_index = newPeep->sprite_index;
@@ -475,6 +582,7 @@ void game_command_set_staff_patrol(sint32 * eax, sint32 * ebx, sint32 * ecx, sin
         {
             gStaffModes[peep->staff_id] |= 2;
         }
+        staff_update_patrol_index(peep);
 
         for (sint32 y2 = 0; y2 < 4; y2++)
         {
@@ -833,6 +941,33 @@ void staff_set_patrol_area(sint32 staffIndex, sint32 x, sint32 y, bool value)
     {
         *addr &= ~(1 << bitIndex);
     }
+
+    if (staffIndex < STAFF_MAX_COUNT)
+    {
+        _patrolQuadStaff[x | y][staffIndex] = value;
+    }
+}
+
+/**
+ * Removes the whole patrol area of a staff member, keeping the patrol area reverse index up to date.
+ */
+void staff_clear_patrol_area(rct_peep * staff)
+{
+    sint32 staffIndex = staff->staff_id;
+    for (sint32 i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
+    {
+        gStaffPatrolAreas[staffIndex * STAFF_PATROL_AREA_SIZE + i] = 0;
+    }
+    gStaffModes[staffIndex] &= ~2;
+
+    if (staffIndex < STAFF_MAX_COUNT)
+    {
+        for (auto &quadStaff : _patrolQuadStaff)
+        {
+            quadStaff[staffIndex] = false;
+        }
+    }
+    staff_update_patrol_index(staff);
 }
 
 void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
@@ -844,6 +979,11 @@ void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
     sint32 offset     = (x | y) >> 5;
     sint32 bitIndex   = (x | y) & 0x1F;
     gStaffPatrolAreas[peepOffset + offset] ^= (1 << bitIndex);
+
+    if (staffIndex < STAFF_MAX_COUNT)
+    {
+        _patrolQuadStaff[x | y].flip(staffIndex);
+    }
 }
 
 /**
@@ -854,24 +994,8 @@ void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
  */
 static uint8 staff_handyman_direction_to_nearest_litter(rct_peep * peep)
 {
-    uint16       nearestLitterDist = (uint16)-1;
-    rct_litter * nearestLitter     = nullptr;
-    rct_litter * litter            = nullptr;
-
-    for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16 distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter     = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    rct_litter * nearestLitter = litter_get_nearest(peep->x, peep->y, peep->z, 0x60);
+    if (nearestLitter == nullptr)
     {
         return 0xFF;
     }
@@ -1438,11 +1562,15 @@ static bool staff_path_finding_misc(rct_peep * peep)
  */
 static void staff_entertainer_update_nearby_peeps(rct_peep * peep)
 {
-    uint16     spriteIndex;
-    rct_peep * guest;
+    static std::vector<uint16> nearbyPeeps;
+    peep_spatial_index_query(peep->x, peep->y, 96, nearbyPeeps);
 
-    FOR_ALL_GUESTS(spriteIndex, guest)
+    for (uint16 spriteIndex : nearbyPeeps)
     {
+        rct_peep * guest = GET_PEEP(spriteIndex);
+        if (guest->type != PEEP_TYPE_GUEST)
+            continue;
+
         if (guest->x == LOCATION_NULL)
             continue;
 
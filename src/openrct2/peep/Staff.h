@@ -105,6 +105,11 @@ void     staff_reset_stats();
 bool     staff_is_patrol_area_set(sint32 staffIndex, sint32 x, sint32 y);
 void     staff_set_patrol_area(sint32 staffIndex, sint32 x, sint32 y, bool value);
 void     staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y);
+void     staff_clear_patrol_area(rct_peep * staff);
+void     staff_reset_patrol_index();
+void     staff_update_patrol_index(rct_peep * staff);
+void     staff_remove_from_patrol_index(rct_peep * staff);
+size_t   staff_get_mechanics_for_location(sint32 x, sint32 y, uint16 * results);
 colour_t staff_get_colour(uint8 staffType);
 bool     staff_set_colour(uint8 staffType, colour_t value);
 uint32   staff_get_available_entertainer_costumes();
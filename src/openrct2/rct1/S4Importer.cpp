@@ -22,6 +22,7 @@
 #include "../core/FileStream.hpp"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
+#include "../core/Math.hpp"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -219,6 +220,8 @@ public:
 
     void Import() override
     {
+        // Let a background save of the current park finish before it is replaced
+        scenario_save_async_wait();
         Initialise();
 
         CreateAvailableObjectMappings();
@@ -1370,6 +1373,7 @@ private:
         }
         // Only the individual patrol areas have been converted, so generate the combined patrol areas of each staff type
         staff_update_greyed_patrol_areas();
+        staff_reset_patrol_index();
     }
 
     void ImportPeep(rct_peep * dst, rct1_peep * src)
@@ -1776,12 +1780,12 @@ private:
     {
         // This is sketchy, ideally we should try to re-create them
         rct_map_animation * s4Animations = _s4.map_animations;
-        for (size_t i = 0; i < RCT1_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_clear();
+        for (size_t i = 0; i < Math::Min<size_t>(_s4.num_map_animations, RCT1_MAX_ANIMATED_OBJECTS); i++)
         {
-            gAnimatedObjects[i] = s4Animations[i];
-            gAnimatedObjects[i].baseZ /= 2;
+            const rct_map_animation &animation = s4Animations[i];
+            map_animation_create(animation.type, animation.x, animation.y, animation.baseZ / 2);
         }
-        gNumMapAnimations = _s4.num_map_animations;
     }
 
     void ImportFinance()
@@ -1951,6 +1955,7 @@ private:
         FixTerrain();
         FixEntrancePositions();
         FixTileElementEntryTypes();
+        footpath_graph_invalidate();
     }
 
     void ImportResearch()
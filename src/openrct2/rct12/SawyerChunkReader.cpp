@@ -15,6 +15,7 @@
 #pragma endregion
 
 #include <algorithm>
+#include <cstring>
 #include "../core/IStream.hpp"
 #include "../core/Math.hpp"
 #include "../core/Memory.hpp"
@@ -28,6 +29,10 @@ constexpr const char * EXCEPTION_MSG_DESTINATION_TOO_SMALL = "Chunk data larger
 constexpr const char * EXCEPTION_MSG_INVALID_CHUNK_ENCODING = "Invalid chunk encoding.";
 constexpr const char * EXCEPTION_MSG_CORRUPT_RLE = "Corrupt RLE compression data.";
 
+// Runs, literals and repeats are copied in blocks of this size when the buffers have room for the
+// overshoot, the extra bytes written are overwritten by the following output
+constexpr size_t WIDE_COPY_SIZE = 16;
+
 class SawyerChunkException : public IOException
 {
 public:
@@ -156,7 +161,8 @@ size_t SawyerChunkReader::DecodeChunk(void * dst, size_t dstCapacity, const void
 size_t SawyerChunkReader::DecodeChunkRLERepeat(void * dst, size_t dstCapacity, const void * src, size_t srcLength)
 {
     auto immBufferLength = MAX_UNCOMPRESSED_CHUNK_SIZE;
-    auto immBuffer = std::make_unique<uint8[]>(immBufferLength);
+    // Left uninitialised, make_unique would clear all 16 MiB for every chunk
+    auto immBuffer = std::unique_ptr<uint8[]>(new uint8[immBufferLength]);
     auto immLength = DecodeChunkRLE(immBuffer.get(), immBufferLength, src, srcLength);
     return DecodeChunkRepeat(dst, dstCapacity, immBuffer.get(), immLength);
 }
@@ -183,7 +189,19 @@ size_t SawyerChunkReader::DecodeChunkRLE(void * dst, size_t dstCapacity, const v
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::fill_n(dst8, count, src8[i]);
+            if ((size_t)(dstEnd - dst8) >= count + WIDE_COPY_SIZE)
+            {
+                uint8 run[WIDE_COPY_SIZE];
+                std::memset(run, src8[i], WIDE_COPY_SIZE);
+                for (size_t j = 0; j < count; j += WIDE_COPY_SIZE)
+                {
+                    std::memcpy(dst8 + j, run, WIDE_COPY_SIZE);
+                }
+            }
+            else
+            {
+                std::fill_n(dst8, count, src8[i]);
+            }
             dst8 += count;
         }
         else
@@ -197,9 +215,20 @@ size_t SawyerChunkReader::DecodeChunkRLE(void * dst, size_t dstCapacity, const v
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::copy_n(src8 + i + 1, rleCodeByte + 1, dst8);
-            dst8 += rleCodeByte + 1;
-            i += rleCodeByte + 1;
+            size_t count = rleCodeByte + 1;
+            if ((size_t)(dstEnd - dst8) >= count + WIDE_COPY_SIZE && srcLength - (i + 1) >= count + WIDE_COPY_SIZE)
+            {
+                for (size_t j = 0; j < count; j += WIDE_COPY_SIZE)
+                {
+                    std::memcpy(dst8 + j, src8 + i + 1 + j, WIDE_COPY_SIZE);
+                }
+            }
+            else
+            {
+                std::copy_n(src8 + i + 1, count, dst8);
+            }
+            dst8 += count;
+            i += count;
         }
     }
     return (uintptr_t)dst8 - (uintptr_t)dst;
@@ -226,7 +255,15 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void * dst, size_t dstCapacity, cons
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::copy_n(copySrc, count, dst8);
+            // Repeats are at most 8 bytes long, copy all 8 at once if they do not overlap the destination
+            if (copySrc + 8 <= dst8 && dst8 + 8 <= dstEnd)
+            {
+                std::memcpy(dst8, copySrc, 8);
+            }
+            else
+            {
+                std::copy_n(copySrc, count, dst8);
+            }
             dst8 += count;
         }
     }
@@ -240,13 +277,6 @@ size_t SawyerChunkReader::DecodeChunkRotate(void * dst, size_t dstCapacity, cons
         throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
     }
 
-    auto src8 = static_cast<const uint8 *>(src);
-    auto dst8 = static_cast<uint8 *>(dst);
-    uint8 code = 1;
-    for (size_t i = 0; i < srcLength; i++)
-    {
-        dst8[i] = ror8(src8[i], code);
-        code = (code + 2) % 8;
-    }
+    sawyercoding_rotate_fn(static_cast<uint8 *>(dst), static_cast<const uint8 *>(src), srcLength, true);
     return srcLength;
 }
@@ -39,8 +39,24 @@ void SawyerChunkWriter::WriteChunk(const void * src, size_t length, SAWYER_ENCOD
     header.encoding = (uint8)encoding;
     header.length = (uint32)length;
 
-    auto data = std::make_unique<uint8[]>(MAX_COMPRESSED_CHUNK_SIZE);
-    size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), (const uint8 *)src, header);
+    // The encoding buffer is shared by all chunks of the writer
+    if (_buffer == nullptr)
+    {
+        _buffer = std::make_unique<uint8[]>(MAX_COMPRESSED_CHUNK_SIZE);
+    }
+    size_t dataLength = sawyercoding_write_chunk_buffer(_buffer.get(), (const uint8 *)src, header);
+
+    Write(_buffer.get(), dataLength);
+}
 
-    _stream->Write(data.get(), dataLength);
+void SawyerChunkWriter::Write(const void * src, size_t length)
+{
+    _stream->Write(src, length);
+    _checksum += sawyercoding_calculate_checksum((const uint8 *)src, length);
+}
+
+void SawyerChunkWriter::WriteChecksum()
+{
+    uint32 checksum = _checksum;
+    _stream->WriteValue(checksum);
 }
@@ -25,11 +25,16 @@ interface IStream;
 /**
  * Writes sawyer encoding chunks to a data stream. This can be used to write
  * SC6 and SV6 files.
+ *
+ * A checksum of all bytes written is kept as they are emitted, so files can be
+ * written to streams that can not be seeked or read back.
  */
 class SawyerChunkWriter final
 {
 private:
     IStream * const _stream = nullptr;
+    uint32 _checksum = 0;
+    std::unique_ptr<uint8[]> _buffer;
 
 public:
     explicit SawyerChunkWriter(IStream * stream);
@@ -54,4 +59,27 @@ public:
     {
         WriteChunk(src, sizeof(T), encoding);
     }
+
+    /**
+     * Writes data that is not encoded as a chunk to the stream, e.g. the entry
+     * in front of a packed object.
+     */
+    void Write(const void * src, size_t length);
+
+    template<typename T>
+    void WriteValue(const T &value)
+    {
+        Write(&value, sizeof(T));
+    }
+
+    /**
+     * Gets the sum of all bytes written so far.
+     */
+    uint32 GetChecksum() const { return _checksum; }
+
+    /**
+     * Writes the checksum of all bytes written so far to the stream, as found at
+     * the end of SC6 and SV6 files.
+     */
+    void WriteChecksum();
 };
@@ -16,6 +16,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
 #include "../core/String.hpp"
@@ -26,7 +30,6 @@
 #include "../object/ObjectRepository.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "S6Exporter.h"
-#include <functional>
 
 #include "../config/Config.h"
 #include "../Game.h"
@@ -42,6 +45,7 @@
 #include "../object/ObjectLimits.h"
 #include "../OpenRCT2.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
 #include "../ride/Ride.h"
 #include "../ride/RideRatings.h"
 #include "../ride/TrackData.h"
@@ -106,7 +110,7 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     if (_s6.header.num_packed_objects > 0)
     {
         IObjectRepository * objRepo = GetObjectRepository();
-        objRepo->WritePackedObjects(stream, ExportObjectsList);
+        objRepo->WritePackedObjects(chunkWriter, ExportObjectsList);
     }
 
     // 3: Write available objects chunk
@@ -136,17 +140,8 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
-    // Determine number of bytes written
-    size_t fileSize = stream->GetLength();
-
-    // Read all written bytes back into a single buffer
-    stream->SetPosition(0);
-    auto   data = std::unique_ptr<uint8, std::function<void(uint8 *)>>(stream->ReadArray<uint8>(fileSize), Memory::Free<uint8>);
-    uint32 checksum = sawyercoding_calculate_checksum(data.get(), fileSize);
-
-    // Write the checksum on the end
-    stream->SetPosition(fileSize);
-    stream->WriteValue(checksum);
+    // Write the checksum of everything written above on the end
+    chunkWriter.WriteChecksum();
 }
 
 void S6Exporter::Export()
@@ -186,7 +181,7 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.tile_elements, gTileElements, sizeof(_s6.tile_elements));
+    ExportTileElements();
 
     _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
     // Sprites needs to be reset before they get used.
@@ -356,8 +351,7 @@ void S6Exporter::Export()
     _s6.saved_view_y        = gSavedViewY;
     _s6.saved_view_zoom     = gSavedViewZoom;
     _s6.saved_view_rotation = gSavedViewRotation;
-    memcpy(_s6.map_animations, gAnimatedObjects, sizeof(_s6.map_animations));
-    _s6.num_map_animations = gNumMapAnimations;
+    _s6.num_map_animations = (uint16)map_animation_get_all(_s6.map_animations, RCT2_MAX_ANIMATED_OBJECTS);
     // pad_0138B582
 
     _s6.ride_ratings_calc_data = gRideRatingsCalcData;
@@ -417,6 +411,32 @@ void S6Exporter::Export()
     game_convert_strings_to_rct2(&_s6);
 }
 
+/**
+ * Writes the elements of each tile after another, the layout map_reorganise_elements creates,
+ * without reorganising the map itself.
+ */
+void S6Exporter::ExportTileElements()
+{
+    rct_tile_element * dst = _s6.tile_elements;
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const rct_tile_element * src = map_get_first_element_at(x, y);
+            do
+            {
+                if (dst == std::end(_s6.tile_elements))
+                {
+                    throw std::runtime_error("Too many tile elements.");
+                }
+                *dst++ = *src;
+            }
+            while (!tile_element_is_last_for_tile(src++));
+        }
+    }
+    std::fill(dst, std::end(_s6.tile_elements), rct_tile_element{});
+}
+
 void S6Exporter::ExportPeepSpawns()
 {
     for (size_t i = 0; i < RCT12_MAX_PEEP_SPAWNS; i++)
@@ -743,11 +763,10 @@ enum {
 };
 
 /**
- *
- *  rct2: 0x006754F5
- * @param flags bit 0: pack objects, 1: save as scenario
+ * Prepares the park for saving and copies it into an exporter. Shared by scenario_save and
+ * scenario_save_async, both of which write the exporter with scenario_save_write.
  */
-sint32 scenario_save(const utf8 * path, sint32 flags)
+static std::unique_ptr<S6Exporter> scenario_save_export(sint32 flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
     {
@@ -763,34 +782,51 @@ sint32 scenario_save(const utf8 * path, sint32 flags)
         window_close_construction_windows();
     }
 
-    map_reorganise_elements();
     viewport_set_saved_view();
 
-    bool result     = false;
-    auto s6exporter = new S6Exporter();
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        IObjectManager * objManager   = GetObjectManager();
+        s6exporter->ExportObjectsList = objManager->GetPackableObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+    return s6exporter;
+}
+
+static void scenario_save_write(S6Exporter * s6exporter, const utf8 * path, sint32 flags)
+{
+    if (flags & S6_SAVE_FLAG_SCENARIO)
+    {
+        s6exporter->SaveScenario(path);
+    }
+    else
+    {
+        s6exporter->SaveGame(path);
+    }
+}
+
+/**
+ *
+ *  rct2: 0x006754F5
+ * @param flags bit 0: pack objects, 1: save as scenario
+ */
+sint32 scenario_save(const utf8 * path, sint32 flags)
+{
+    // The park may be saved over an autosave that is still being written
+    scenario_save_async_wait();
+
+    bool result = false;
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            IObjectManager * objManager   = GetObjectManager();
-            s6exporter->ExportObjectsList = objManager->GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
+        auto s6exporter = scenario_save_export(flags);
+        scenario_save_write(s6exporter.get(), path, flags);
         result = true;
     }
     catch (const std::exception &)
     {
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
@@ -801,3 +837,63 @@ sint32 scenario_save(const utf8 * path, sint32 flags)
     return result;
 }
 
+static std::thread _asyncSaveThread;
+
+/**
+ * Saves the park without blocking the game. The park state is copied into the exporter on the
+ * calling thread, as it has to be from a single tick. The chunk encoding, checksum and file write
+ * then happen on a worker thread. The file is written under a temporary name and replaces the
+ * previous file in one step, so that an interrupted save never leaves a truncated park behind.
+ */
+void scenario_save_async(const utf8 * path, sint32 flags)
+{
+    // Only one save may be in flight
+    scenario_save_async_wait();
+
+    std::unique_ptr<S6Exporter> s6exporter;
+    try
+    {
+        s6exporter = scenario_save_export(flags);
+    }
+    catch (const std::exception &e)
+    {
+        log_error("Unable to save park: %s", e.what());
+        return;
+    }
+
+    gfx_invalidate_screen();
+
+    std::string savePath = path;
+    _asyncSaveThread = std::thread([s6exporter = std::move(s6exporter), savePath, flags]()
+    {
+        std::string tempPath = savePath + ".tmp";
+        try
+        {
+            scenario_save_write(s6exporter.get(), tempPath.c_str(), flags);
+        }
+        catch (const std::exception &e)
+        {
+            log_error("Unable to save park to '%s': %s", savePath.c_str(), e.what());
+            platform_file_delete(tempPath.c_str());
+            return;
+        }
+
+        if (!platform_file_replace(tempPath.c_str(), savePath.c_str()))
+        {
+            log_error("Unable to move '%s' to '%s'", tempPath.c_str(), savePath.c_str());
+            platform_file_delete(tempPath.c_str());
+        }
+    });
+}
+
+/**
+ * Blocks until the park passed to the last scenario_save_async call has been written.
+ */
+void scenario_save_async_wait()
+{
+    if (_asyncSaveThread.joinable())
+    {
+        _asyncSaveThread.join();
+    }
+}
+
@@ -53,4 +53,5 @@ private:
     void ExportResearchedSceneryItems();
     void ExportResearchList();
     void ExportPeepSpawns();
+    void ExportTileElements();
 };
@@ -18,6 +18,7 @@
 #include "../core/Console.hpp"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/Math.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../management/Award.h"
@@ -195,6 +196,8 @@ public:
 
     void Import() override
     {
+        // Let a background save of the current park finish before it is replaced
+        scenario_save_async_wait();
         Initialise();
 
         // _s6.header
@@ -386,11 +389,12 @@ public:
         gSavedViewZoom     = _s6.saved_view_zoom;
         gSavedViewRotation = _s6.saved_view_rotation;
 
-        for (size_t i = 0; i < RCT2_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_clear();
+        for (size_t i = 0; i < Math::Min<size_t>(_s6.num_map_animations, RCT2_MAX_ANIMATED_OBJECTS); i++)
         {
-            gAnimatedObjects[i] = _s6.map_animations[i];
+            const rct_map_animation &animation = _s6.map_animations[i];
+            map_animation_create(animation.type, animation.x, animation.y, animation.baseZ);
         }
-        gNumMapAnimations = _s6.num_map_animations;
         // pad_0138B582
 
         gRideRatingsCalcData = _s6.ride_ratings_calc_data;
@@ -399,6 +403,7 @@ public:
         gGrassSceneryTileLoopPosition = _s6.grass_and_scenery_tilepos;
         memcpy(gStaffPatrolAreas, _s6.patrol_areas, sizeof(_s6.patrol_areas));
         memcpy(gStaffModes, _s6.staff_modes, sizeof(_s6.staff_modes));
+        staff_reset_patrol_index();
         // unk_13CA73E
         // pad_13CA73F
         gUnk13CA740 = _s6.byte_13CA740;
@@ -446,6 +451,11 @@ public:
         }
         map_strip_ghost_flag_from_elements();
         map_update_tile_pointers();
+        if (_s6.num_map_animations >= RCT2_MAX_ANIMATED_OBJECTS)
+        {
+            // Parks can have more animations than a saved game has room for
+            map_animation_auto_create();
+        }
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
@@ -16,6 +16,7 @@
 
 #include <climits>
 #include <cstdlib>
+#include <vector>
 
 #include "../audio/audio.h"
 #include "../audio/AudioMixer.h"
@@ -2706,6 +2707,36 @@ rct_peep *ride_find_closest_mechanic(Ride *ride, sint32 forInspection)
     return find_closest_mechanic(x, y, forInspection);
 }
 
+static bool ride_can_mechanic_respond(rct_peep *peep, sint32 x, sint32 y, sint32 forInspection)
+{
+    if (peep->staff_type != STAFF_TYPE_MECHANIC)
+        return false;
+
+    if (!forInspection) {
+        if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
+            if (peep->sub_state >= 4)
+                return false;
+        }
+        else if (peep->state != PEEP_STATE_PATROLLING)
+            return false;
+
+        if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
+            return false;
+    } else {
+        if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
+            return false;
+    }
+
+    if (map_is_location_in_park(x, y))
+        if (!staff_is_location_in_patrol(peep, x & 0xFFE0, y & 0xFFE0))
+            return false;
+
+    if (peep->x == LOCATION_NULL)
+        return false;
+
+    return true;
+}
+
 /**
  *
  *  rct2: 0x006B774B (forInspection = 0)
@@ -2714,34 +2745,17 @@ rct_peep *ride_find_closest_mechanic(Ride *ride, sint32 forInspection)
 rct_peep *find_closest_mechanic(sint32 x, sint32 y, sint32 forInspection)
 {
     uint32 closestDistance, distance;
-    uint16 spriteIndex;
     rct_peep *peep, *closestMechanic = nullptr;
 
-    closestDistance = UINT_MAX;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
-
-        if (!forInspection) {
-            if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
-                if (peep->sub_state >= 4)
-                    continue;
-            }
-            else if (peep->state != PEEP_STATE_PATROLLING)
-                continue;
+    // Only visit the mechanics whose patrol area allows them to work here
+    uint16 candidates[STAFF_MAX_COUNT];
+    size_t numCandidates = staff_get_mechanics_for_location(x, y, candidates);
 
-            if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
-                continue;
-        } else {
-            if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
-        }
-
-        if (map_is_location_in_park(x, y))
-            if (!staff_is_location_in_patrol(peep, x & 0xFFE0, y & 0xFFE0))
-                continue;
-
-        if (peep->x == LOCATION_NULL)
+    // Candidates are in staff id order, so equally close mechanics are chosen by lowest staff id
+    closestDistance = UINT_MAX;
+    for (size_t i = 0; i < numCandidates; i++) {
+        peep = GET_PEEP(candidates[i]);
+        if (!ride_can_mechanic_respond(peep, x, y, forInspection))
             continue;
 
         // Manhattan distance
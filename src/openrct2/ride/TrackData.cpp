@@ -29723,6 +29723,47 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[17] = {
     TrackVehicleInfoList_8BAD28,
 };
 
+static constexpr uint16 TrackVehicleInfoListSizes[17] = {
+    Util::CountOf(TrackVehicleInfoList_8B8F98),
+    Util::CountOf(TrackVehicleInfoList_8BBAB8),
+    Util::CountOf(TrackVehicleInfoList_8BC588),
+    Util::CountOf(TrackVehicleInfoList_8BCBD8),
+    Util::CountOf(TrackVehicleInfoList_8BD228),
+    Util::CountOf(TrackVehicleInfoList_8BD878),
+    Util::CountOf(TrackVehicleInfoList_8BDBB8),
+    Util::CountOf(TrackVehicleInfoList_8BDEF8),
+    Util::CountOf(TrackVehicleInfoList_8BE238),
+    Util::CountOf(TrackVehicleInfoList_9334D0),
+    Util::CountOf(TrackVehicleInfoList_9341B0),
+    Util::CountOf(TrackVehicleInfoList_934E90),
+    Util::CountOf(TrackVehicleInfoList_935B70),
+    Util::CountOf(TrackVehicleInfoList_936850),
+    Util::CountOf(TrackVehicleInfoList_937530),
+    Util::CountOf(TrackVehicleInfoList_8B9F98),
+    Util::CountOf(TrackVehicleInfoList_8BAD28),
+};
+
+static constexpr rct_vehicle_info_table BuildTrackVehicleInfoTable()
+{
+    rct_vehicle_info_table table = {};
+    uint16 row = 0;
+    for (size_t cd = 0; cd < Util::CountOf(TrackVehicleInfoListSizes); cd++)
+    {
+        table.row_start[cd] = row;
+        table.row_count[cd] = TrackVehicleInfoListSizes[cd];
+        for (uint16 i = 0; i < TrackVehicleInfoListSizes[cd]; i++)
+        {
+            table.rows[row++] = *gTrackVehicleInfo[cd][i];
+        }
+    }
+    return table;
+}
+
+// Built at compile time, saves vehicle_get_move_info one dependent load per car sub-step
+constexpr rct_vehicle_info_table gTrackVehicleInfoTable = BuildTrackVehicleInfoTable();
+static_assert(gTrackVehicleInfoTable.row_start[16] + gTrackVehicleInfoTable.row_count[16] == TRACK_VEHICLE_INFO_ROW_COUNT,
+              "TRACK_VEHICLE_INFO_ROW_COUNT does not match the size of gTrackVehicleInfo");
+
 /** rct2: 0x00993D1C */
 const sint16 AlternativeTrackTypes[256] = {
     TRACK_ELEM_FLAT_COVERED,                        // TRACK_ELEM_FLAT
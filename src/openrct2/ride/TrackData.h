@@ -67,6 +67,21 @@ struct rct_vehicle_info_list
 
 extern const rct_vehicle_info_list * const * const gTrackVehicleInfo[17];
 
+constexpr size_t TRACK_VEHICLE_INFO_ROW_COUNT = 10440;
+
+/**
+ * gTrackVehicleInfo flattened into one contiguous table, the rows of each cd start at row_start[cd]
+ * and are indexed by track type and direction.
+ */
+struct rct_vehicle_info_table
+{
+    uint16                  row_start[17];
+    uint16                  row_count[17];
+    rct_vehicle_info_list   rows[TRACK_VEHICLE_INFO_ROW_COUNT];
+};
+
+extern const rct_vehicle_info_table gTrackVehicleInfoTable;
+
 extern const sint16 AlternativeTrackTypes[256];
 
 extern const money32 TrackPricing[256];
@@ -79,6 +79,10 @@ public:
     }
 
 public:
+    /**
+     * Runs on the indexing worker threads. track_design_open only works on its own buffers and the
+     * constant RCT1 conversion tables, it does not touch the active track design.
+     */
     std::tuple<bool, TrackRepositoryItem> Create(const std::string &path) const override
     {
         auto td6 = track_design_open(path.c_str());
@@ -761,73 +761,31 @@ static const struct
 
 // clang-format on
 
-static bool vehicle_move_info_valid(sint32 cd, sint32 typeAndDirection, sint32 offset)
+const rct_vehicle_info_list * vehicle_get_move_info_list(sint32 cd, sint32 typeAndDirection)
 {
-    if (cd >= static_cast<sint32>(Util::CountOf(gTrackVehicleInfo)))
+    if ((uint32)cd >= Util::CountOf(gTrackVehicleInfoTable.row_count) ||
+        (uint32)typeAndDirection >= gTrackVehicleInfoTable.row_count[cd])
     {
-        return false;
+        static constexpr const rct_vehicle_info_list empty = { 0, nullptr };
+        return &empty;
     }
-    sint32 size = 0;
-    switch (cd)
-    {
-    case 0:
-        size = 1024;
-        break;
-    case 1:
-        size = 692;
-        break;
-    case 2:
-    case 3:
-    case 4:
-        size = 404;
-        break;
-    case 5:
-    case 6:
-    case 7:
-    case 8:
-        size = 208;
-        break;
-    case 9:
-    case 10:
-    case 11:
-    case 12:
-    case 13:
-    case 14:
-        size = 824;
-        break;
-    case 15:
-    case 16:
-        size = 868;
-        break;
-    }
-    if (typeAndDirection >= size)
-    {
-        return false;
-    }
-    if (offset >= gTrackVehicleInfo[cd][typeAndDirection]->size)
-    {
-        return false;
-    }
-    return true;
+    return &gTrackVehicleInfoTable.rows[gTrackVehicleInfoTable.row_start[cd] + typeAndDirection];
 }
 
 const rct_vehicle_info * vehicle_get_move_info(sint32 cd, sint32 typeAndDirection, sint32 offset)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, offset))
+    const rct_vehicle_info_list * moveInfoList = vehicle_get_move_info_list(cd, typeAndDirection);
+    if ((uint32)offset >= moveInfoList->size)
     {
         static constexpr const rct_vehicle_info zero = { 0 };
         return &zero;
     }
-    return &gTrackVehicleInfo[cd][typeAndDirection]->info[offset];
+    return &moveInfoList->info[offset];
 }
 
 uint16 vehicle_get_move_info_size(sint32 cd, sint32 typeAndDirection)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, 0))
-    {
-        return 0;
-    }
-    return gTrackVehicleInfo[cd][typeAndDirection]->size;
+    return vehicle_get_move_info_list(cd, typeAndDirection)->size;
 }
 
 rct_vehicle * try_get_vehicle(uint16 spriteIndex)
@@ -8267,8 +8225,6 @@ loc_6DAEB9:
 
     regs.ax = vehicle->track_progress + 1;
 
-    const rct_vehicle_info * moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, 0);
-
     // Track Total Progress is in the two bytes before the move info list
     uint16 trackTotalProgress = vehicle_get_move_info_size(vehicle->var_CD, vehicle->track_type);
     if (regs.ax >= trackTotalProgress)
@@ -8284,9 +8240,9 @@ loc_6DAEB9:
     vehicle_update_handle_water_splash(vehicle);
 
     // loc_6DB706
-    moveInfo  = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, vehicle->track_progress);
     trackType = vehicle->track_type >> 2;
     {
+        const rct_vehicle_info * moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, vehicle->track_progress);
         sint16 x = vehicle->track_x + moveInfo->x;
         sint16 y = vehicle->track_y + moveInfo->y;
         sint16 z = vehicle->track_z + moveInfo->z + RideData5[ride->type].z_offset;
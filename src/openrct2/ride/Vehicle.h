@@ -400,6 +400,8 @@ void vehicle_test_reset(rct_vehicle* vehicle);
 void vehicle_peep_easteregg_here_we_are(rct_vehicle* vehicle);
 rct_vehicle *vehicle_get_head(rct_vehicle *vehicle);
 rct_vehicle *vehicle_get_tail(rct_vehicle *vehicle);
+struct rct_vehicle_info_list;
+const rct_vehicle_info_list *vehicle_get_move_info_list(sint32 cd, sint32 typeAndDirection);
 const rct_vehicle_info *vehicle_get_move_info(sint32 cd, sint32 typeAndDirection, sint32 offset);
 uint16 vehicle_get_move_info_size(sint32 cd, sint32 typeAndDirection);
 bool vehicle_update_dodgems_collision(rct_vehicle *vehicle, sint16 x, sint16 y, uint16 *spriteId);
@@ -402,6 +402,8 @@ uint32 scenario_rand_max(uint32 max);
 
 bool scenario_prepare_for_save();
 sint32 scenario_save(const utf8 * path, sint32 flags);
+void scenario_save_async(const utf8 * path, sint32 flags);
+void scenario_save_async_wait();
 void scenario_remove_trackless_rides(rct_s6_data *s6);
 void scenario_fix_ghosts(rct_s6_data *s6);
 void scenario_failure();
@@ -141,6 +141,10 @@ public:
     }
 
 protected:
+    /**
+     * Runs on the indexing worker threads. The S4 importer instance is local to the call and only
+     * reads the scenario sources and language tables, which do not change while indexing.
+     */
     std::tuple<bool, scenario_index_entry> Create(const std::string &path) const override
     {
         scenario_index_entry entry;
@@ -225,8 +229,9 @@ private:
                         result = true;
                     }
                 }
-                catch (const std::exception &)
+                catch (const std::exception &e)
                 {
+                    Console::Error::WriteLine("Unable to read scenario: '%s': %s", path.c_str(), e.what());
                 }
                 return result;
             }
@@ -249,9 +254,9 @@ private:
                 }
             }
         }
-        catch (const std::exception &)
+        catch (const std::exception &e)
         {
-            Console::Error::WriteLine("Unable to read scenario: '%s'", path.c_str());
+            Console::Error::WriteLine("Unable to read scenario: '%s': %s", path.c_str(), e.what());
         }
         return false;
     }
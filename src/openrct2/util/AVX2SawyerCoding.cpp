@@ -0,0 +1,163 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+#include "Util.h"
+
+// Loading 32 bytes at offset j gives the candidates that are far enough back to match byte j
+static constexpr const uint8 RepeatCandidateMask[40] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+size_t sawyercoding_encode_repeat_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length)
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    uint8 * dstStart = dst;
+
+    // Need to emit at least one byte, otherwise there is nothing to repeat
+    *dst++ = 255;
+    *dst++ = src[0];
+
+    for (size_t i = 1; i < length; )
+    {
+        size_t repeatIndex = 0;
+        size_t repeatCount;
+        if (i >= 32 && i + 8 <= length)
+        {
+            // Lane k counts the matching bytes of the candidate starting at i - 32 + k
+            const uint8 * candidates = src + i - 32;
+            __m256i matched = _mm256_set1_epi8(-1);
+            __m256i count = _mm256_setzero_si256();
+            for (sint32 j = 0; j < 8; j++)
+            {
+                const __m256i value = _mm256_set1_epi8((char)src[i + j]);
+                const __m256i valid = _mm256_loadu_si256((const __m256i *)(RepeatCandidateMask + j));
+                const __m256i eq    = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(candidates + j)), value);
+                matched = _mm256_and_si256(matched, _mm256_and_si256(eq, valid));
+                count = _mm256_sub_epi8(count, matched);
+            }
+
+            __m128i best = _mm_max_epu8(_mm256_castsi256_si128(count), _mm256_extracti128_si256(count, 1));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 8));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 4));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 2));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 1));
+            repeatCount = (uint8)_mm_cvtsi128_si32(best);
+            if (repeatCount != 0)
+            {
+                // The earliest candidate wins ties, like the scalar search
+                const __m256i bestCount = _mm256_set1_epi8((char)repeatCount);
+                uint32 lanes = (uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(count, bestCount));
+                repeatIndex = i - 32 + bitscanforward((sint32)lanes);
+            }
+        }
+        else
+        {
+            repeatCount = sawyercoding_find_repeat_scalar(src, length, i, &repeatIndex);
+        }
+
+        if (repeatCount == 0)
+        {
+            *dst++ = 255;
+            *dst++ = src[i];
+            i++;
+        }
+        else
+        {
+            *dst++ = (uint8)((repeatCount - 1) | ((32 - (i - repeatIndex)) << 3));
+            i += repeatCount;
+        }
+    }
+    return dst - dstStart;
+}
+
+void sawyercoding_rotate_avx2(uint8 * dst, const uint8 * src, size_t length, bool decode)
+{
+    // Each byte is rotated by shifting the 16-bit lanes both ways, the masks of a rotation amount
+    // only keep the bits that stay within the bytes using that amount
+    __m256i leftMasks[4];
+    __m256i rightMasks[4];
+    __m128i leftShifts[4];
+    __m128i rightShifts[4];
+    for (sint32 b = 0; b < 4; b++)
+    {
+        sint32 shift = 1 + 2 * b;
+        if (decode)
+        {
+            shift = 8 - shift;
+        }
+
+        uint8 leftMask[32] = {};
+        uint8 rightMask[32] = {};
+        for (sint32 lane = b; lane < 32; lane += 4)
+        {
+            leftMask[lane] = (uint8)(0xFF << shift);
+            rightMask[lane] = (uint8)(0xFF >> (8 - shift));
+        }
+        leftMasks[b] = _mm256_loadu_si256((const __m256i *)leftMask);
+        rightMasks[b] = _mm256_loadu_si256((const __m256i *)rightMask);
+        leftShifts[b] = _mm_cvtsi32_si128(shift);
+        rightShifts[b] = _mm_cvtsi32_si128(8 - shift);
+    }
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i data = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i result = _mm256_setzero_si256();
+        for (sint32 b = 0; b < 4; b++)
+        {
+            result = _mm256_or_si256(result, _mm256_and_si256(_mm256_sll_epi16(data, leftShifts[b]), leftMasks[b]));
+            result = _mm256_or_si256(result, _mm256_and_si256(_mm256_srl_epi16(data, rightShifts[b]), rightMasks[b]));
+        }
+        _mm256_storeu_si256((__m256i *)(dst + i), result);
+    }
+
+    // The pattern repeats every 4 bytes, so the remainder continues where the loop stopped
+    sawyercoding_rotate_scalar(dst + i, src + i, length - i, decode);
+}
+
+#else
+
+#ifdef OPENRCT2_X86
+#error You have to compile this file with AVX2 enabled, when targetting x86!
+#endif
+
+size_t sawyercoding_encode_repeat_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+    return 0;
+}
+
+void sawyercoding_rotate_avx2(uint8 * dst, const uint8 * src, size_t length, bool decode)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#endif // __AVX2__
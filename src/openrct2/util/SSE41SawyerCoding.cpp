@@ -0,0 +1,169 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+
+#ifdef __SSE4_1__
+
+#include <immintrin.h>
+#include "Util.h"
+
+// Loading 16 bytes at offset j gives the upper 16 candidates that are far enough back to match byte j
+static constexpr const uint8 RepeatCandidateMask[24] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length)
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    uint8 * dstStart = dst;
+
+    // Need to emit at least one byte, otherwise there is nothing to repeat
+    *dst++ = 255;
+    *dst++ = src[0];
+
+    for (size_t i = 1; i < length; )
+    {
+        size_t repeatIndex = 0;
+        size_t repeatCount;
+        if (i >= 32 && i + 8 <= length)
+        {
+            // Lane k counts the matching bytes of the candidate starting at i - 32 + k,
+            // the lower 16 candidates are in lo and the upper 16 in hi
+            const uint8 * candidates = src + i - 32;
+            __m128i matchedLo = _mm_set1_epi8(-1);
+            __m128i matchedHi = matchedLo;
+            __m128i countLo = _mm_setzero_si128();
+            __m128i countHi = countLo;
+            for (sint32 j = 0; j < 8; j++)
+            {
+                const __m128i value = _mm_set1_epi8((char)src[i + j]);
+                const __m128i valid = _mm_loadu_si128((const __m128i *)(RepeatCandidateMask + j));
+                const __m128i eqLo  = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(candidates + j)), value);
+                const __m128i eqHi  = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(candidates + j + 16)), value);
+                matchedLo = _mm_and_si128(matchedLo, eqLo);
+                matchedHi = _mm_and_si128(matchedHi, _mm_and_si128(eqHi, valid));
+                countLo = _mm_sub_epi8(countLo, matchedLo);
+                countHi = _mm_sub_epi8(countHi, matchedHi);
+            }
+
+            __m128i best = _mm_max_epu8(countLo, countHi);
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 8));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 4));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 2));
+            best = _mm_max_epu8(best, _mm_srli_si128(best, 1));
+            repeatCount = (uint8)_mm_cvtsi128_si32(best);
+            if (repeatCount != 0)
+            {
+                // The earliest candidate wins ties, like the scalar search
+                const __m128i bestCount = _mm_set1_epi8((char)repeatCount);
+                uint32 lanes = (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(countLo, bestCount)) |
+                               ((uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(countHi, bestCount)) << 16);
+                repeatIndex = i - 32 + bitscanforward((sint32)lanes);
+            }
+        }
+        else
+        {
+            repeatCount = sawyercoding_find_repeat_scalar(src, length, i, &repeatIndex);
+        }
+
+        if (repeatCount == 0)
+        {
+            *dst++ = 255;
+            *dst++ = src[i];
+            i++;
+        }
+        else
+        {
+            *dst++ = (uint8)((repeatCount - 1) | ((32 - (i - repeatIndex)) << 3));
+            i += repeatCount;
+        }
+    }
+    return dst - dstStart;
+}
+
+void sawyercoding_rotate_sse4_1(uint8 * dst, const uint8 * src, size_t length, bool decode)
+{
+    // Each byte is rotated by shifting the 16-bit lanes both ways, the masks of a rotation amount
+    // only keep the bits that stay within the bytes using that amount
+    __m128i leftMasks[4];
+    __m128i rightMasks[4];
+    __m128i leftShifts[4];
+    __m128i rightShifts[4];
+    for (sint32 b = 0; b < 4; b++)
+    {
+        sint32 shift = 1 + 2 * b;
+        if (decode)
+        {
+            shift = 8 - shift;
+        }
+
+        uint8 leftMask[16] = {};
+        uint8 rightMask[16] = {};
+        for (sint32 lane = b; lane < 16; lane += 4)
+        {
+            leftMask[lane] = (uint8)(0xFF << shift);
+            rightMask[lane] = (uint8)(0xFF >> (8 - shift));
+        }
+        leftMasks[b] = _mm_loadu_si128((const __m128i *)leftMask);
+        rightMasks[b] = _mm_loadu_si128((const __m128i *)rightMask);
+        leftShifts[b] = _mm_cvtsi32_si128(shift);
+        rightShifts[b] = _mm_cvtsi32_si128(8 - shift);
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i result = _mm_setzero_si128();
+        for (sint32 b = 0; b < 4; b++)
+        {
+            result = _mm_or_si128(result, _mm_and_si128(_mm_sll_epi16(data, leftShifts[b]), leftMasks[b]));
+            result = _mm_or_si128(result, _mm_and_si128(_mm_srl_epi16(data, rightShifts[b]), rightMasks[b]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), result);
+    }
+
+    // The pattern repeats every 4 bytes, so the remainder continues where the loop stopped
+    sawyercoding_rotate_scalar(dst + i, src + i, length - i, decode);
+}
+
+#else
+
+#ifdef OPENRCT2_X86
+#error You have to compile this file with SSE4.1 enabled, when targetting x86!
+#endif
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+void sawyercoding_rotate_sse4_1(uint8 * dst, const uint8 * src, size_t length, bool decode)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#endif // __SSE4_1__
@@ -26,11 +26,34 @@ static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_
 static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize);
 
 static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
-static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
-static void encode_chunk_rotate(uint8 *buffer, size_t length);
 
 bool gUseRLE = true;
 
+size_t (*sawyercoding_encode_repeat_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length) = sawyercoding_encode_repeat_scalar;
+void (*sawyercoding_rotate_fn)(uint8 * dst, const uint8 * src, size_t length, bool decode) = sawyercoding_rotate_scalar;
+
+void sawyercoding_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 sawyer coding functions");
+        sawyercoding_encode_repeat_fn = sawyercoding_encode_repeat_avx2;
+        sawyercoding_rotate_fn = sawyercoding_rotate_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 sawyer coding functions");
+        sawyercoding_encode_repeat_fn = sawyercoding_encode_repeat_sse4_1;
+        sawyercoding_rotate_fn = sawyercoding_rotate_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar sawyer coding functions");
+        sawyercoding_encode_repeat_fn = sawyercoding_encode_repeat_scalar;
+        sawyercoding_rotate_fn = sawyercoding_rotate_scalar;
+    }
+}
+
 uint32 sawyercoding_calculate_checksum(const uint8* buffer, size_t length)
 {
     size_t i;
@@ -74,7 +97,7 @@ size_t sawyercoding_write_chunk_buffer(uint8 *dst_file, const uint8* buffer, saw
     case CHUNK_ENCODING_RLECOMPRESSED:
         encode_buffer = (uint8 *)malloc(chunkHeader.length * 2);
         encode_buffer2 = (uint8 *)malloc(0x600000);
-        chunkHeader.length = (uint32)encode_chunk_repeat(buffer, encode_buffer, chunkHeader.length);
+        chunkHeader.length = (uint32)sawyercoding_encode_repeat_fn(buffer, encode_buffer, chunkHeader.length);
         chunkHeader.length = (uint32)encode_chunk_rle(encode_buffer, encode_buffer2, chunkHeader.length);
         memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
         dst_file += sizeof(sawyercoding_chunk_header);
@@ -84,14 +107,9 @@ size_t sawyercoding_write_chunk_buffer(uint8 *dst_file, const uint8* buffer, saw
         free(encode_buffer);
         break;
     case CHUNK_ENCODING_ROTATE:
-        encode_buffer = (uint8 *)malloc(chunkHeader.length);
-        memcpy(encode_buffer, buffer, chunkHeader.length);
-        encode_chunk_rotate(encode_buffer, chunkHeader.length);
         memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
         dst_file += sizeof(sawyercoding_chunk_header);
-        memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-        free(encode_buffer);
+        sawyercoding_rotate_fn(dst_file, buffer, chunkHeader.length, false);
         break;
     }
 
@@ -296,7 +314,46 @@ static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_
     return dst - dst_buffer;
 }
 
-static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
+/**
+ * Finds the longest earlier sequence, within the last 32 bytes, that matches the data at position i.
+ * @param repeatIndex Set to the start of the sequence, the earliest one is used if several are as long.
+ * @returns The number of matching bytes, 0 if there is no match.
+ */
+size_t sawyercoding_find_repeat_scalar(const uint8 * src, size_t length, size_t i, size_t * repeatIndex)
+{
+    size_t searchIndex = (i < 32) ? 0 : (i - 32);
+    size_t searchEnd = i - 1;
+
+    size_t bestRepeatIndex = 0;
+    size_t bestRepeatCount = 0;
+    for (size_t index = searchIndex; index <= searchEnd; index++) {
+        size_t repeatCount = 0;
+        size_t maxRepeatCount = Math::Min(Math::Min((size_t)7, searchEnd - index), length - i - 1);
+        // maxRepeatCount should not exceed length
+        assert(index + maxRepeatCount < length);
+        assert(i + maxRepeatCount < length);
+        for (size_t j = 0; j <= maxRepeatCount; j++) {
+            if (src[index + j] == src[i + j]) {
+                repeatCount++;
+            } else {
+                break;
+            }
+        }
+        if (repeatCount > bestRepeatCount) {
+            bestRepeatIndex = index;
+            bestRepeatCount = repeatCount;
+
+            // Maximum repeat count is 8
+            if (repeatCount == 8)
+                break;
+        }
+    }
+
+    *repeatIndex = bestRepeatIndex;
+    return bestRepeatCount;
+}
+
+size_t sawyercoding_encode_repeat_scalar(const uint8 * RESTRICT src_buffer, uint8 * RESTRICT dst_buffer, size_t length)
 {
     if (length == 0)
         return 0;
@@ -310,34 +367,8 @@ static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, si
 
     // Iterate through remainder of the source buffer
     for (size_t i = 1; i < length; ) {
-        size_t searchIndex = (i < 32) ? 0 : (i - 32);
-        size_t searchEnd = i - 1;
-
-        size_t bestRepeatIndex = 0;
-        size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++) {
-            size_t repeatCount = 0;
-            size_t maxRepeatCount = Math::Min(Math::Min((size_t)7, searchEnd - repeatIndex), length - i - 1);
-            // maxRepeatCount should not exceed length
-            assert(repeatIndex + maxRepeatCount < length);
-            assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++) {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j]) {
-                    repeatCount++;
-                } else {
-                    break;
-                }
-            }
-            if (repeatCount > bestRepeatCount) {
-                bestRepeatIndex = repeatIndex;
-                bestRepeatCount = repeatCount;
-
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
-                    break;
-            }
-        }
-
+        size_t bestRepeatIndex;
+        size_t bestRepeatCount = sawyercoding_find_repeat_scalar(src_buffer, length, i, &bestRepeatIndex);
         if (bestRepeatCount == 0) {
             *dst_buffer++ = 255;
             *dst_buffer++ = src_buffer[i];
@@ -353,12 +384,15 @@ static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, si
     return outLength;
 }
 
-static void encode_chunk_rotate(uint8 *buffer, size_t length)
+/**
+ * Rotates each byte by 1, 3, 5 or 7 bits, repeating every 4 bytes. Encoding rotates left, decoding right.
+ * src and dst may be the same buffer.
+ */
+void sawyercoding_rotate_scalar(uint8 * dst, const uint8 * src, size_t length, bool decode)
 {
-    size_t i;
     uint8 code = 1;
-    for (i = 0; i < length; i++) {
-        buffer[i] = rol8(buffer[i], code);
+    for (size_t i = 0; i < length; i++) {
+        dst[i] = decode ? ror8(src[i], code) : rol8(src[i], code);
         code = (code + 2) % 8;
     }
 }
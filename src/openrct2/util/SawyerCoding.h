@@ -61,4 +61,18 @@ sint32 sawyercoding_validate_track_checksum(const uint8* src, size_t length);
 sint32 sawyercoding_detect_file_type(const uint8 *src, size_t length);
 sint32 sawyercoding_detect_rct1_version(sint32 gameVersion);
 
+// Chunk encoding kernels, sawyercoding_init selects the fastest the CPU supports
+size_t sawyercoding_find_repeat_scalar(const uint8 * src, size_t length, size_t i, size_t * repeatIndex);
+size_t sawyercoding_encode_repeat_scalar(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length);
+size_t sawyercoding_encode_repeat_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length);
+size_t sawyercoding_encode_repeat_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length);
+void sawyercoding_rotate_scalar(uint8 * dst, const uint8 * src, size_t length, bool decode);
+void sawyercoding_rotate_sse4_1(uint8 * dst, const uint8 * src, size_t length, bool decode);
+void sawyercoding_rotate_avx2(uint8 * dst, const uint8 * src, size_t length, bool decode);
+
+extern size_t (*sawyercoding_encode_repeat_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, size_t length);
+extern void (*sawyercoding_rotate_fn)(uint8 * dst, const uint8 * src, size_t length, bool decode);
+
+void sawyercoding_init();
+
 #endif
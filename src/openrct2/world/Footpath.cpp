@@ -1227,6 +1227,8 @@ static bool sub_footpath_disconnect_queue_from_path(sint32 x, sint32 y, rct_tile
     sint32 z = tileElement->base_height;
     rct_tile_element *otherTileElement = footpath_get_element(x1, y1, z - 2, z, direction);
     if (otherTileElement != nullptr && !footpath_element_is_queue(otherTileElement)) {
+        footpath_graph_invalidate_tile(x >> 5, y >> 5);
+        footpath_graph_invalidate_tile(x1 >> 5, y1 >> 5);
         tileElement->properties.path.type &= ~FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
         if (action > 0) {
             tileElement->properties.path.edges &= ~(1 << direction);
@@ -1360,6 +1362,7 @@ static void loc_6A6D7E(
                 neighbour_list_push(neighbourList, 2, direction, 255, 255);
             }
         } else {
+            footpath_graph_invalidate_tile(x >> 5, y >> 5);
             footpath_disconnect_queue_from_path(x, y, tileElement, 1 + ((flags >> 6) & 1));
             tileElement->properties.path.edges |= (1 << (direction ^ 2));
             if (footpath_element_is_queue(tileElement)) {
@@ -1375,6 +1378,7 @@ static void loc_6A6D7E(
 loc_6A6FD2:
     if (tile_element_get_type(initialTileElement) == TILE_ELEMENT_TYPE_PATH) {
         if (!query) {
+            footpath_graph_invalidate_tile(initialX >> 5, initialY >> 5);
             initialTileElement->properties.path.edges |= (1 << direction);
             map_invalidate_element(initialX, initialY, initialTileElement);
         }
@@ -1434,6 +1438,7 @@ void footpath_connect_edges(sint32 x, sint32 y, rct_tile_element *tileElement, s
     rct_neighbour_list neighbourList;
     rct_neighbour neighbour;
 
+    footpath_graph_invalidate_tile(x >> 5, y >> 5);
     footpath_update_queue_chains();
 
     neighbour_list_init(&neighbourList);
@@ -1541,6 +1546,7 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
                 }
             }
 
+            footpath_graph_invalidate_tile(x >> 5, y >> 5);
             tileElement->properties.path.type &= ~FOOTPATH_PROPERTIES_FLAG_HAS_QUEUE_BANNER;
             tileElement->properties.path.edges |= (1 << (direction ^ 2));
             tileElement->properties.path.ride_index = rideIndex;
@@ -1813,6 +1819,7 @@ bool footpath_element_is_sloped(const rct_tile_element * tileElement)
 
 void footpath_element_set_sloped(rct_tile_element * tileElement, bool isSloped)
 {
+    footpath_graph_invalidate_element(tileElement);
     tileElement->properties.path.type &= ~FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
     if (isSloped)
         tileElement->properties.path.type |= FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
@@ -1830,11 +1837,13 @@ bool footpath_element_is_queue(const rct_tile_element * tileElement)
 
 void footpath_element_set_queue(rct_tile_element * tileElement)
 {
+    footpath_graph_invalidate_element(tileElement);
     tileElement->type |= FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
 }
 
 void footpath_element_clear_queue(rct_tile_element * tileElement)
 {
+    footpath_graph_invalidate_element(tileElement);
     tileElement->type &= ~FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
 }
 
@@ -1850,6 +1859,7 @@ bool footpath_element_is_wide(const rct_tile_element * tileElement)
 
 void footpath_element_set_wide(rct_tile_element * tileElement, bool isWide)
 {
+    footpath_graph_invalidate_element(tileElement);
     tileElement->type &= ~FOOTPATH_ELEMENT_TYPE_FLAG_IS_WIDE;
     if (isWide)
         tileElement->type |= FOOTPATH_ELEMENT_TYPE_FLAG_IS_WIDE;
@@ -1970,6 +1980,7 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
     if (y > 0x1FDF)
         return;
 
+    footpath_graph_invalidate_tile(x >> 5, y >> 5);
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -2162,6 +2173,7 @@ void footpath_update_queue_entrance_banner(sint32 x, sint32 y, rct_tile_element
                 }
             }
             tileElement->properties.path.ride_index = 255;
+            footpath_graph_invalidate_tile(x >> 5, y >> 5);
         }
         break;
     case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -2185,6 +2197,7 @@ static void footpath_remove_edges_towards_here(sint32 x, sint32 y, sint32 z, sin
         footpath_queue_chain_push(tileElement->properties.path.ride_index);
     }
 
+    footpath_graph_invalidate_tile(x >> 5, y >> 5);
     d = direction ^ 2;
     tileElement->properties.path.edges &= ~(1 << d);
     d = ((d - 1) & 3) + 4;
@@ -2364,6 +2377,7 @@ static void footpath_fix_corners_around(sint32 x, sint32 y, rct_tile_element * p
  */
 void footpath_remove_edges_at(sint32 x, sint32 y, rct_tile_element *tileElement)
 {
+    footpath_graph_invalidate_tile(x >> 5, y >> 5);
     if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_TRACK) {
         sint32 rideIndex = track_element_get_ride_index(tileElement);
         Ride *ride = get_ride(rideIndex);
@@ -177,4 +177,10 @@ void footpath_queue_chain_push(uint8 rideIndex);
 
 uint8 footpath_get_edges(const rct_tile_element * element);
 
+void footpath_graph_invalidate();
+void footpath_graph_invalidate_tile(sint32 x, sint32 y);
+void footpath_graph_invalidate_element(const rct_tile_element * tileElement);
+sint32 footpath_graph_choose_direction(sint32 x, sint32 y, sint32 z, uint8 edges, const LocationXYZ16 &goal,
+                                       uint8 queueRideIndex, bool ignoreForeignQueues);
+
 #endif
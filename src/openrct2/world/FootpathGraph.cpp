@@ -0,0 +1,602 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <vector>
+#include "../peep/Peep.h"
+#include "../ride/Ride.h"
+#include "../ride/Track.h"
+#include "../util/Util.h"
+#include "Entrance.h"
+#include "Footpath.h"
+#include "Map.h"
+
+/**
+ * A graph of all walkable footpath tiles and the destinations guests can walk into (ride entrances
+ * and exits, park entrances and shops). The graph is built from the map the first time it is used
+ * and after loading a park. After that only the tiles whose paths, banners, entrances or shops have
+ * been changed are read again, and only the edges from and to those tiles are recalculated. Nodes are
+ * stored by tile coordinates, so moving the elements in memory (e.g. map_reorganise_elements) keeps
+ * the graph valid. Distances from every
+ * node to a goal are calculated with a breadth first search the first time a goal is requested and
+ * cached until the nodes or edges change.
+ *
+ * The graph follows the same rules as the guest heuristic search: no-entry banners block edges,
+ * ride entrances and exits can only be entered in their facing direction, queues of other rides
+ * cannot be walked through and wide paths are only walked onto from other wide paths or when they
+ * are the goal. Unlike the heuristic search there are no limits on the number of tiles or junctions.
+ */
+
+#define FOOTPATH_GRAPH_DISTANCE_NULL 0xFFFF
+#define FOOTPATH_GRAPH_NODE_NULL 0xFFFFFFFF
+#define FOOTPATH_GRAPH_MAX_CACHED_GOALS 128
+#define FOOTPATH_GRAPH_TILE_COUNT (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
+
+enum
+{
+    FOOTPATH_GRAPH_NODE_PATH,
+    FOOTPATH_GRAPH_NODE_RIDE_ENTRANCE,
+    FOOTPATH_GRAPH_NODE_RIDE_EXIT,
+    FOOTPATH_GRAPH_NODE_PARK_ENTRANCE,
+    FOOTPATH_GRAPH_NODE_SHOP,
+    FOOTPATH_GRAPH_NODE_FREE,
+};
+
+struct footpath_graph_edge
+{
+    uint32 node;
+    uint8 direction;
+};
+
+struct footpath_graph_node
+{
+    uint8 x;
+    uint8 y;
+    uint8 z;
+    uint8 type;
+    // Slope direction of the path or 0xFF if the path is flat
+    uint8 slope_direction;
+    uint8 permitted_edges;
+    // Ride index of a two-edged queue, these can only be walked through by guests heading for that ride
+    uint8 queue_ride_index;
+    bool wide;
+    // Outgoing edges ordered by direction, only paths have any
+    std::vector<footpath_graph_edge> edges;
+
+    bool IsSameAs(const footpath_graph_node &other) const
+    {
+        return type == other.type && z == other.z && slope_direction == other.slope_direction &&
+            permitted_edges == other.permitted_edges && queue_ride_index == other.queue_ride_index &&
+            wide == other.wide;
+    }
+};
+
+struct footpath_graph_goal
+{
+    uint8 x;
+    uint8 y;
+    uint8 z;
+    uint8 queue_ride_index;
+    bool ignore_foreign_queues;
+    std::vector<uint16> distances;
+};
+
+static bool _graphValid = false;
+// Nodes keep their index until their tile changes, removed nodes are reused
+static std::vector<footpath_graph_node> _graphNodes;
+static std::vector<uint32> _graphFreeNodes;
+// The nodes of each tile in tile element order
+static std::vector<std::vector<uint32>> _graphTileNodes;
+static std::vector<uint32> _graphDirtyTiles;
+static std::vector<bool> _graphTileIsDirty;
+static std::vector<footpath_graph_goal> _graphGoals;
+static size_t _graphNextGoalSlot = 0;
+
+static uint8 footpath_graph_get_permitted_edges(rct_tile_element * tileElement)
+{
+    uint8 edges = tileElement->properties.path.edges;
+    for (rct_tile_element * bannerElement = get_banner_on_path(tileElement); bannerElement != nullptr;
+         bannerElement = get_banner_on_path(bannerElement))
+    {
+        edges &= bannerElement->properties.banner.flags;
+    }
+    return edges & 0x0F;
+}
+
+static size_t footpath_graph_get_tile_index(sint32 x, sint32 y)
+{
+    return x * MAXIMUM_MAP_SIZE_TECHNICAL + y;
+}
+
+/**
+ * Reads the nodes of a tile from the map, without any edges.
+ */
+static void footpath_graph_read_tile_nodes(sint32 x, sint32 y, std::vector<footpath_graph_node> &nodes)
+{
+    nodes.clear();
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    if (tileElement == nullptr)
+        return;
+
+    do
+    {
+        if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+            continue;
+
+        footpath_graph_node node = { (uint8)x, (uint8)y, tileElement->base_height, FOOTPATH_GRAPH_NODE_PATH, 0xFF, 0, 0xFF, false };
+        switch (tile_element_get_type(tileElement))
+        {
+        case TILE_ELEMENT_TYPE_PATH:
+        {
+            // Overlaid paths at the same height are merged the same way peep_pathfind_choose_direction does,
+            // the edges are combined and the first path decides the slope.
+            bool merged = false;
+            for (auto &existing : nodes)
+            {
+                if (existing.type == FOOTPATH_GRAPH_NODE_PATH && existing.z == node.z)
+                {
+                    existing.permitted_edges |= footpath_graph_get_permitted_edges(tileElement);
+                    existing.wide |= footpath_element_is_wide(tileElement);
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged)
+                continue;
+
+            if (footpath_element_is_sloped(tileElement))
+            {
+                node.slope_direction = footpath_element_get_slope_direction(tileElement);
+            }
+            node.permitted_edges = footpath_graph_get_permitted_edges(tileElement);
+            node.wide = footpath_element_is_wide(tileElement);
+            if (footpath_element_is_queue(tileElement) && bitcount(footpath_get_edges(tileElement)) == 2)
+            {
+                node.queue_ride_index = tileElement->properties.path.ride_index;
+            }
+            break;
+        }
+        case TILE_ELEMENT_TYPE_TRACK:
+        {
+            Ride * ride = get_ride(track_element_get_ride_index(tileElement));
+            if (!ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                continue;
+            node.type = FOOTPATH_GRAPH_NODE_SHOP;
+            break;
+        }
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            switch (tileElement->properties.entrance.type)
+            {
+            case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                node.type = FOOTPATH_GRAPH_NODE_RIDE_ENTRANCE;
+                break;
+            case ENTRANCE_TYPE_RIDE_EXIT:
+                node.type = FOOTPATH_GRAPH_NODE_RIDE_EXIT;
+                break;
+            case ENTRANCE_TYPE_PARK_ENTRANCE:
+                node.type = FOOTPATH_GRAPH_NODE_PARK_ENTRANCE;
+                break;
+            default:
+                continue;
+            }
+            // Entrances and exits can only be walked into in the direction they face
+            node.permitted_edges = 1 << tile_element_get_direction(tileElement);
+            break;
+        default:
+            continue;
+        }
+        nodes.push_back(node);
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+}
+
+/**
+ * Replaces the nodes of a tile, returns whether they differ from the nodes the tile had before.
+ */
+static bool footpath_graph_set_tile_nodes(size_t tileIndex, std::vector<footpath_graph_node> &nodes)
+{
+    auto &tileNodes = _graphTileNodes[tileIndex];
+    if (tileNodes.size() == nodes.size())
+    {
+        bool same = true;
+        for (size_t i = 0; i < nodes.size() && same; i++)
+        {
+            same = _graphNodes[tileNodes[i]].IsSameAs(nodes[i]);
+        }
+        if (same)
+            return false;
+    }
+
+    for (uint32 nodeIndex : tileNodes)
+    {
+        _graphNodes[nodeIndex].type = FOOTPATH_GRAPH_NODE_FREE;
+        _graphNodes[nodeIndex].edges.clear();
+        _graphFreeNodes.push_back(nodeIndex);
+    }
+    tileNodes.clear();
+
+    for (auto &node : nodes)
+    {
+        uint32 nodeIndex;
+        if (_graphFreeNodes.empty())
+        {
+            nodeIndex = (uint32)_graphNodes.size();
+            _graphNodes.push_back(std::move(node));
+        }
+        else
+        {
+            nodeIndex = _graphFreeNodes.back();
+            _graphFreeNodes.pop_back();
+            _graphNodes[nodeIndex] = std::move(node);
+        }
+        tileNodes.push_back(nodeIndex);
+    }
+    return true;
+}
+
+static void footpath_graph_update_edges(uint32 nodeIndex)
+{
+    footpath_graph_node &node = _graphNodes[nodeIndex];
+    node.edges.clear();
+    if (node.type != FOOTPATH_GRAPH_NODE_PATH)
+        return;
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if (!(node.permitted_edges & (1 << direction)))
+            continue;
+
+        sint32 nextX = node.x + TileDirectionDelta[direction].x / 32;
+        sint32 nextY = node.y + TileDirectionDelta[direction].y / 32;
+        if (nextX < 0 || nextY < 0 || nextX >= MAXIMUM_MAP_SIZE_TECHNICAL || nextY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+            continue;
+
+        sint32 height = node.z;
+        if (node.slope_direction == direction)
+        {
+            height += 2;
+        }
+
+        for (uint32 next : _graphTileNodes[footpath_graph_get_tile_index(nextX, nextY)])
+        {
+            const footpath_graph_node &nextNode = _graphNodes[next];
+            bool connected;
+            if (nextNode.type == FOOTPATH_GRAPH_NODE_PATH)
+            {
+                // Same rules as is_valid_path_z_and_direction
+                if (nextNode.slope_direction == 0xFF)
+                    connected = height == nextNode.z;
+                else if (nextNode.slope_direction == direction)
+                    connected = height == nextNode.z;
+                else
+                    connected = (nextNode.slope_direction ^ 2) == direction && height == nextNode.z + 2;
+            }
+            else if (nextNode.type == FOOTPATH_GRAPH_NODE_RIDE_ENTRANCE || nextNode.type == FOOTPATH_GRAPH_NODE_RIDE_EXIT)
+            {
+                connected = height == nextNode.z && (nextNode.permitted_edges & (1 << direction));
+            }
+            else
+            {
+                connected = height == nextNode.z;
+            }
+
+            if (connected)
+            {
+                node.edges.push_back({ next, (uint8)direction });
+            }
+        }
+    }
+}
+
+static void footpath_graph_update_tile_edges(sint32 x, sint32 y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    for (uint32 nodeIndex : _graphTileNodes[footpath_graph_get_tile_index(x, y)])
+    {
+        footpath_graph_update_edges(nodeIndex);
+    }
+}
+
+static void footpath_graph_build()
+{
+    _graphNodes.clear();
+    _graphFreeNodes.clear();
+    _graphTileNodes.assign(FOOTPATH_GRAPH_TILE_COUNT, std::vector<uint32>());
+    _graphDirtyTiles.clear();
+    _graphTileIsDirty.assign(FOOTPATH_GRAPH_TILE_COUNT, false);
+    _graphGoals.clear();
+    _graphNextGoalSlot = 0;
+
+    std::vector<footpath_graph_node> nodes;
+    for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+    {
+        for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            footpath_graph_read_tile_nodes(x, y, nodes);
+            footpath_graph_set_tile_nodes(footpath_graph_get_tile_index(x, y), nodes);
+        }
+    }
+    for (uint32 i = 0; i < _graphNodes.size(); i++)
+    {
+        footpath_graph_update_edges(i);
+    }
+
+    _graphValid = true;
+}
+
+/**
+ * Reads the invalidated tiles again. When their nodes changed, the edges from them and from their
+ * neighbours are recalculated and the cached goal distances are discarded.
+ */
+static void footpath_graph_update_dirty_tiles()
+{
+    if (_graphDirtyTiles.empty())
+        return;
+
+    std::vector<footpath_graph_node> nodes;
+    std::vector<uint32> changedTiles;
+    for (uint32 tileIndex : _graphDirtyTiles)
+    {
+        _graphTileIsDirty[tileIndex] = false;
+        sint32 x = tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL;
+        sint32 y = tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL;
+        footpath_graph_read_tile_nodes(x, y, nodes);
+        if (footpath_graph_set_tile_nodes(tileIndex, nodes))
+        {
+            changedTiles.push_back(tileIndex);
+        }
+    }
+    _graphDirtyTiles.clear();
+
+    if (changedTiles.empty())
+        return;
+
+    for (uint32 tileIndex : changedTiles)
+    {
+        sint32 x = tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL;
+        sint32 y = tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL;
+        footpath_graph_update_tile_edges(x, y);
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            footpath_graph_update_tile_edges(x + TileDirectionDelta[direction].x / 32, y + TileDirectionDelta[direction].y / 32);
+        }
+    }
+    _graphGoals.clear();
+    _graphNextGoalSlot = 0;
+}
+
+/**
+ * Whether a guest may walk along the edge from one node into the next one on the way to a goal.
+ * Wide paths are only walked onto from other wide paths unless they are the goal.
+ */
+static bool footpath_graph_can_walk_onto(const footpath_graph_node &from, const footpath_graph_node &to, uint16 toDistance)
+{
+    return toDistance == 0 || !to.wide || from.wide;
+}
+
+static const footpath_graph_goal * footpath_graph_get_goal(uint8 x, uint8 y, uint8 z, uint8 queueRideIndex, bool ignoreForeignQueues)
+{
+    for (const auto &goal : _graphGoals)
+    {
+        if (goal.x == x && goal.y == y && goal.z == z && goal.queue_ride_index == queueRideIndex &&
+            goal.ignore_foreign_queues == ignoreForeignQueues)
+        {
+            return &goal;
+        }
+    }
+
+    // Recycle the oldest goal once the cache is full
+    if (_graphGoals.size() < FOOTPATH_GRAPH_MAX_CACHED_GOALS)
+    {
+        _graphGoals.emplace_back();
+        _graphNextGoalSlot = _graphGoals.size() - 1;
+    }
+    footpath_graph_goal &goal = _graphGoals[_graphNextGoalSlot];
+    _graphNextGoalSlot = (_graphNextGoalSlot + 1) % FOOTPATH_GRAPH_MAX_CACHED_GOALS;
+
+    goal.x = x;
+    goal.y = y;
+    goal.z = z;
+    goal.queue_ride_index = queueRideIndex;
+    goal.ignore_foreign_queues = ignoreForeignQueues;
+    goal.distances.assign(_graphNodes.size(), FOOTPATH_GRAPH_DISTANCE_NULL);
+
+    std::vector<uint32> queue;
+    for (uint32 i : _graphTileNodes[footpath_graph_get_tile_index(x, y)])
+    {
+        if (_graphNodes[i].z == z)
+        {
+            goal.distances[i] = 0;
+            queue.push_back(i);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        uint32 current = queue[head];
+        uint16 distance = goal.distances[current];
+        if (distance == FOOTPATH_GRAPH_DISTANCE_NULL - 1)
+            continue;
+
+        // Edges into the current node come from paths on the neighbouring tiles
+        const footpath_graph_node &currentNode = _graphNodes[current];
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            sint32 previousX = currentNode.x - TileDirectionDelta[direction].x / 32;
+            sint32 previousY = currentNode.y - TileDirectionDelta[direction].y / 32;
+            if (previousX < 0 || previousY < 0 || previousX >= MAXIMUM_MAP_SIZE_TECHNICAL || previousY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                continue;
+
+            for (uint32 previous : _graphTileNodes[footpath_graph_get_tile_index(previousX, previousY)])
+            {
+                if (goal.distances[previous] != FOOTPATH_GRAPH_DISTANCE_NULL)
+                    continue;
+
+                const footpath_graph_node &previousNode = _graphNodes[previous];
+                bool hasEdge = false;
+                for (const auto &edge : previousNode.edges)
+                {
+                    if (edge.node == current && edge.direction == direction)
+                    {
+                        hasEdge = true;
+                        break;
+                    }
+                }
+                if (!hasEdge || !footpath_graph_can_walk_onto(previousNode, currentNode, distance))
+                    continue;
+
+                // Guests can not walk through queues of other rides
+                if (ignoreForeignQueues && previousNode.queue_ride_index != 0xFF && previousNode.queue_ride_index != queueRideIndex)
+                    continue;
+
+                goal.distances[previous] = distance + 1;
+                queue.push_back(previous);
+            }
+        }
+    }
+    return &goal;
+}
+
+void footpath_graph_invalidate()
+{
+    _graphValid = false;
+}
+
+/**
+ * Marks a tile to be read again the next time the graph is used. Called wherever the map changes a
+ * path, banner, entrance or shop on the tile.
+ */
+void footpath_graph_invalidate_tile(sint32 x, sint32 y)
+{
+    if (!_graphValid)
+        return;
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    size_t tileIndex = footpath_graph_get_tile_index(x, y);
+    if (!_graphTileIsDirty[tileIndex])
+    {
+        _graphTileIsDirty[tileIndex] = true;
+        _graphDirtyTiles.push_back((uint32)tileIndex);
+    }
+}
+
+/**
+ * Marks the tile of an element to be read again, for changes that only know the element. Must be
+ * called before the element is moved or removed.
+ */
+void footpath_graph_invalidate_element(const rct_tile_element * tileElement)
+{
+    if (!_graphValid || (tileElement->flags & TILE_ELEMENT_FLAG_GHOST))
+        return;
+
+    switch (tile_element_get_type(tileElement))
+    {
+    case TILE_ELEMENT_TYPE_PATH:
+    case TILE_ELEMENT_TYPE_ENTRANCE:
+    case TILE_ELEMENT_TYPE_BANNER:
+        break;
+    case TILE_ELEMENT_TYPE_TRACK:
+        if (!ride_type_has_flag(get_ride(track_element_get_ride_index(tileElement))->type, RIDE_TYPE_FLAG_IS_SHOP))
+            return;
+        break;
+    default:
+        return;
+    }
+
+    // The elements of a tile follow each other, preceded by the last element of another tile or free space
+    const rct_tile_element * firstElement = tileElement;
+    while (firstElement > gTileElements && !tile_element_is_last_for_tile(firstElement - 1) &&
+           (firstElement - 1)->base_height != 0xFF)
+    {
+        firstElement--;
+    }
+
+    // The tile either has nodes already or has been invalidated since the graph was last updated
+    for (const auto &node : _graphNodes)
+    {
+        if (node.type != FOOTPATH_GRAPH_NODE_FREE && map_get_first_element_at(node.x, node.y) == firstElement)
+        {
+            footpath_graph_invalidate_tile(node.x, node.y);
+            return;
+        }
+    }
+    for (uint32 tileIndex : _graphDirtyTiles)
+    {
+        if (map_get_first_element_at(tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL, tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL) == firstElement)
+            return;
+    }
+
+    log_warning("Footpath graph has no tile for changed element, rebuilding it");
+    footpath_graph_invalidate();
+}
+
+/**
+ * Chooses the edge that leads to the goal in the fewest steps, from the path at the given tile
+ * coordinates. Only the given edges are considered, earlier edges win ties.
+ * @returns the chosen direction or -1 if the goal can not be reached through any of the edges.
+ */
+sint32 footpath_graph_choose_direction(sint32 x, sint32 y, sint32 z, uint8 edges, const LocationXYZ16 &goal,
+                                       uint8 queueRideIndex, bool ignoreForeignQueues)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return -1;
+    if (goal.x < 0 || goal.y < 0 || (goal.x >> 5) >= MAXIMUM_MAP_SIZE_TECHNICAL || (goal.y >> 5) >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return -1;
+
+    if (!_graphValid)
+    {
+        footpath_graph_build();
+    }
+    footpath_graph_update_dirty_tiles();
+
+    uint32 start = FOOTPATH_GRAPH_NODE_NULL;
+    for (uint32 i : _graphTileNodes[footpath_graph_get_tile_index(x, y)])
+    {
+        if (_graphNodes[i].type == FOOTPATH_GRAPH_NODE_PATH && _graphNodes[i].z == z)
+        {
+            start = i;
+            break;
+        }
+    }
+    if (start == FOOTPATH_GRAPH_NODE_NULL)
+        return -1;
+
+    const footpath_graph_goal * graphGoal = footpath_graph_get_goal(
+        (uint8)(goal.x >> 5), (uint8)(goal.y >> 5), (uint8)goal.z, queueRideIndex, ignoreForeignQueues);
+
+    const footpath_graph_node &startNode = _graphNodes[start];
+    sint32 bestDirection = -1;
+    uint16 bestDistance = FOOTPATH_GRAPH_DISTANCE_NULL;
+    for (const auto &edge : startNode.edges)
+    {
+        if (!(edges & (1 << edge.direction)))
+            continue;
+
+        uint16 distance = graphGoal->distances[edge.node];
+        if (!footpath_graph_can_walk_onto(startNode, _graphNodes[edge.node], distance))
+            continue;
+
+        // Edges are ordered by direction, so the first edge wins ties
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            bestDirection = edge.direction;
+        }
+    }
+    return bestDirection;
+}
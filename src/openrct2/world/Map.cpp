@@ -14,6 +14,8 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <vector>
+
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../config/Config.h"
@@ -108,6 +110,18 @@ PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 rct_tile_element *gNextFreeTileElement;
 uint32 gNextFreeTileElementPointerIndex;
 
+// Background compaction of gTileElements, see map_compact_elements_step
+static constexpr uint32 TILE_ELEMENT_COMPACT_ELEMENTS_PER_TICK = 4096;
+static constexpr uint32 TILE_ELEMENT_COMPACT_START_THRESHOLD = (MAX_TILE_ELEMENTS / 4) * 3;
+static constexpr uint32 TILE_ELEMENT_COMPACT_MIN_GROWTH = 1024;
+static constexpr uint32 TILE_ELEMENT_COMPACT_NO_TILE = 0xFFFFFFFF;
+
+static bool _tileElementCompactActive;
+static uint32 _tileElementCompactRead;
+static uint32 _tileElementCompactWrite;
+static uint32 _tileElementCompactLastEnd;
+static std::vector<uint32> _tileElementCompactTileAt;
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -125,6 +139,7 @@ static void map_update_grass_length(sint32 x, sint32 y, rct_tile_element *tileEl
 static void map_set_grass_length(sint32 x, sint32 y, rct_tile_element *tileElement, sint32 length);
 static void clear_elements_at(sint32 x, sint32 y);
 static void translate_3d_to_2d(sint32 rotation, sint32 *x, sint32 *y);
+static void map_set_tile_pointers();
 
 void rotate_map_coordinates(sint16 *x, sint16 *y, sint32 rotation)
 {
@@ -399,7 +414,7 @@ rct_tile_element* map_get_banner_element_at(sint32 x, sint32 y, sint32 z, uint8
  */
 void map_init(sint32 size)
 {
-    gNumMapAnimations = 0;
+    map_animation_clear();
     gNextFreeTileElementPointerIndex = 0;
 
     for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++) {
@@ -495,6 +510,17 @@ void map_strip_ghost_flag_from_elements()
  *  rct2: 0x0068AFFD
  */
 void map_update_tile_pointers()
+{
+    map_set_tile_pointers();
+
+    // The elements have been replaced, e.g. by loading a park
+    footpath_graph_invalidate();
+}
+
+/**
+ * Points every tile at its elements, which must follow each other in tile order.
+ */
+static void map_set_tile_pointers()
 {
     sint32 i, x, y;
 
@@ -512,6 +538,10 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+
+    // The elements have been laid out from scratch, any compaction in progress is obsolete
+    _tileElementCompactActive = false;
+    _tileElementCompactLastEnd = 0;
 }
 
 /**
@@ -681,6 +711,10 @@ void sub_68B089()
     if (gTrackDesignSaveMode)
         return;
 
+    // Tiles must not be moved behind map_compact_elements_step's cursors
+    if (_tileElementCompactActive)
+        return;
+
     i = gNextFreeTileElementPointerIndex;
     do {
         i++;
@@ -718,6 +752,100 @@ void sub_68B089()
 }
 
 
+static void map_compact_elements_begin()
+{
+    // Remember where each tile starts so that runs of elements can be traced back to their tile
+    _tileElementCompactTileAt.assign(Util::CountOf(gTileElements), TILE_ELEMENT_COMPACT_NO_TILE);
+    for (uint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        rct_tile_element * tileElement = gTileElementTilePointers[i];
+        if (tileElement != TILE_UNDEFINED_TILE_ELEMENT)
+        {
+            _tileElementCompactTileAt[tileElement - gTileElements] = i;
+        }
+    }
+    _tileElementCompactActive = true;
+    _tileElementCompactRead = 0;
+    _tileElementCompactWrite = 0;
+}
+
+static void map_compact_elements_end()
+{
+    // Everything from the write cursor onwards is free
+    gNextFreeTileElement = gTileElements + _tileElementCompactWrite;
+    _tileElementCompactActive = false;
+    _tileElementCompactLastEnd = _tileElementCompactWrite;
+    _tileElementCompactTileAt.clear();
+    _tileElementCompactTileAt.shrink_to_fit();
+}
+
+/**
+ * Moves a bounded number of tile elements down into the free gaps left by removed and moved tiles,
+ * so that map_reorganise_elements rarely has to compact the whole map at once. A pass starts when
+ * the used part of gTileElements grows past a threshold and walks it in address order. Each tile is
+ * moved down to the write cursor and its tile pointer updated. Tiles created since the pass started
+ * are left where they are.
+ */
+void map_compact_elements_step()
+{
+    if (gTrackDesignSaveMode)
+        return;
+
+    if (!_tileElementCompactActive)
+    {
+        uint32 used = (uint32)(gNextFreeTileElement - gTileElements);
+        if (used < TILE_ELEMENT_COMPACT_START_THRESHOLD || used < _tileElementCompactLastEnd + TILE_ELEMENT_COMPACT_MIN_GROWTH)
+            return;
+        map_compact_elements_begin();
+    }
+
+    uint32 budget = TILE_ELEMENT_COMPACT_ELEMENTS_PER_TICK;
+    uint32 end = (uint32)(gNextFreeTileElement - gTileElements);
+    while (budget > 0 && _tileElementCompactRead < end)
+    {
+        uint32 read = _tileElementCompactRead;
+        rct_tile_element * src = &gTileElements[read];
+        if (src->base_height == 255)
+        {
+            _tileElementCompactRead++;
+            budget--;
+            continue;
+        }
+
+        uint32 length = 1;
+        while (!tile_element_is_last_for_tile(&src[length - 1]))
+            length++;
+
+        uint32 tileIndex = read < _tileElementCompactTileAt.size() ? _tileElementCompactTileAt[read] : TILE_ELEMENT_COMPACT_NO_TILE;
+        if (tileIndex != TILE_ELEMENT_COMPACT_NO_TILE && gTileElementTilePointers[tileIndex] == src)
+        {
+            uint32 write = _tileElementCompactWrite;
+            if (write < read)
+            {
+                memmove(&gTileElements[write], src, length * sizeof(rct_tile_element));
+                for (uint32 i = Math::Max(read, write + length); i < read + length; i++)
+                {
+                    gTileElements[i].base_height = 255;
+                }
+                gTileElementTilePointers[tileIndex] = &gTileElements[write];
+            }
+            _tileElementCompactWrite = write + length;
+        }
+        else
+        {
+            // Not a tile known when the pass started, leave it in place
+            _tileElementCompactWrite = read + length;
+        }
+        _tileElementCompactRead = read + length;
+        budget -= Math::Min(budget, length);
+    }
+
+    if (_tileElementCompactRead >= end)
+    {
+        map_compact_elements_end();
+    }
+}
+
 /**
  * Checks if the tile at coordinate at height counts as connected.
  * @return 1 if connected, 0 otherwise
@@ -2927,6 +3055,8 @@ sint32 tile_element_get_station(const rct_tile_element * tileElement)
  */
 void tile_element_remove(rct_tile_element *tileElement)
 {
+    footpath_graph_invalidate_element(tileElement);
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -3092,7 +3222,8 @@ void map_reorganise_elements()
 
     free(new_tile_elements);
 
-    map_update_tile_pointers();
+    // The tiles keep their elements, so the footpath graph stays valid
+    map_set_tile_pointers();
 }
 
 /**
@@ -3140,6 +3271,10 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
+    if (_tileElementCompactActive && (size_t)(newTileElement - gTileElements) < _tileElementCompactTileAt.size())
+    {
+        _tileElementCompactTileAt[newTileElement - gTileElements] = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+    }
 
     // Copy all elements that are below the insert height
     while (z >= originalTileElement->base_height) {
@@ -3177,6 +3312,7 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
     }
 
     gNextFreeTileElement = newTileElement;
+    footpath_graph_invalidate_tile(x, y);
     return insertedElement;
 }
 
@@ -4475,6 +4611,11 @@ void game_command_modify_tile(sint32* eax, sint32* ebx, sint32* ecx, sint32* edx
         break;
     }
 
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && *ebx != MONEY32_UNDEFINED)
+    {
+        footpath_graph_invalidate_tile(x, y);
+    }
+
     if (flags & GAME_COMMAND_FLAG_APPLY &&
             gGameCommandNestLevel == 1 &&
             !(flags & GAME_COMMAND_FLAG_GHOST) &&
@@ -14,7 +14,8 @@
  *****************************************************************************/
 #pragma endregion
 
-#include <cstring>
+#include <unordered_set>
+#include <vector>
 
 #include "../Game.h"
 #include "../ride/Ride.h"
@@ -32,8 +33,14 @@ using map_animation_invalidate_event_handler = bool (*)(sint32 x, sint32 y, sint
 
 static bool map_animation_invalidate(rct_map_animation *obj);
 
-uint16 gNumMapAnimations;
-rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
+// One bucket per animation type, removed animations are swapped with the last one of their bucket
+static std::vector<rct_map_animation> _mapAnimations[MAP_ANIMATION_TYPE_COUNT];
+static std::unordered_set<uint64> _mapAnimationKeys;
+
+static uint64 map_animation_get_key(const rct_map_animation &animation)
+{
+    return ((uint64)animation.type << 40) | ((uint64)animation.baseZ << 32) | ((uint32)animation.x << 16) | animation.y;
+}
 
 /**
  *
@@ -46,31 +53,23 @@ rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
  */
 void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z)
 {
-    rct_map_animation *aobj = &gAnimatedObjects[0];
-    sint32 numAnimatedObjects = gNumMapAnimations;
-    if (numAnimatedObjects >= MAX_ANIMATED_OBJECTS) {
-        log_error("Exceeded the maximum number of animations");
+    if (type < 0 || type >= MAP_ANIMATION_TYPE_COUNT)
+    {
+        log_error("Invalid map animation type %d", type);
         return;
     }
-    for (sint32 i = 0; i < numAnimatedObjects; i++, aobj++) {
-        if (aobj->x != x)
-            continue;
-        if (aobj->y != y)
-            continue;
-        if (aobj->baseZ != z)
-            continue;
-        if (aobj->type != type)
-            continue;
+
+    rct_map_animation animation;
+    animation.type = type;
+    animation.x = x;
+    animation.y = y;
+    animation.baseZ = z;
+    if (!_mapAnimationKeys.insert(map_animation_get_key(animation)).second)
+    {
         // Animation already exists
         return;
     }
-
-    // Create new animation
-    gNumMapAnimations++;
-    aobj->type = type;
-    aobj->x = x;
-    aobj->y = y;
-    aobj->baseZ = z;
+    _mapAnimations[type].push_back(animation);
 }
 
 /**
@@ -79,18 +78,173 @@ void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z)
  */
 void map_animation_invalidate_all()
 {
-    rct_map_animation *aobj = &gAnimatedObjects[0];
-    sint32 numAnimatedObjects = gNumMapAnimations;
-    while (numAnimatedObjects > 0) {
-        if (map_animation_invalidate(aobj)) {
-            // Remove animated object
-            gNumMapAnimations--;
-            numAnimatedObjects--;
-            if (numAnimatedObjects > 0)
-                memmove(aobj, aobj + 1, numAnimatedObjects * sizeof(rct_map_animation));
-        } else {
-            numAnimatedObjects--;
-            aobj++;
+    for (auto &bucket : _mapAnimations)
+    {
+        size_t i = 0;
+        while (i < bucket.size())
+        {
+            if (map_animation_invalidate(&bucket[i]))
+            {
+                // Remove animated object, the last one takes its place and is invalidated next
+                _mapAnimationKeys.erase(map_animation_get_key(bucket[i]));
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+}
+
+void map_animation_clear()
+{
+    for (auto &bucket : _mapAnimations)
+    {
+        bucket.clear();
+    }
+    _mapAnimationKeys.clear();
+}
+
+size_t map_animation_get_count()
+{
+    return _mapAnimationKeys.size();
+}
+
+/**
+ * Copies the animations in the order they are invalidated, so that loading them with
+ * map_animation_create gives the same order again.
+ * @returns the number of animations copied.
+ */
+size_t map_animation_get_all(rct_map_animation * animations, size_t capacity)
+{
+    size_t count = 0;
+    for (const auto &bucket : _mapAnimations)
+    {
+        for (const auto &animation : bucket)
+        {
+            if (count >= capacity)
+            {
+                return count;
+            }
+            animations[count++] = animation;
+        }
+    }
+    return count;
+}
+
+/**
+ * Creates the animations of every animated element on the map. Saved games only have room for
+ * a limited number of animations, this restores the ones that did not fit.
+ */
+void map_animation_auto_create()
+{
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            rct_tile_element * tileElement = map_get_first_element_at(x, y);
+            if (tileElement == nullptr)
+            {
+                continue;
+            }
+
+            do
+            {
+                sint32 type = -1;
+                // Doors and on-ride photos that were still moving when saved also need their animation
+                sint32 activeType = -1;
+                switch (tile_element_get_type(tileElement))
+                {
+                case TILE_ELEMENT_TYPE_ENTRANCE:
+                    if (tileElement->properties.entrance.type == ENTRANCE_TYPE_RIDE_ENTRANCE)
+                    {
+                        type = MAP_ANIMATION_TYPE_RIDE_ENTRANCE;
+                    }
+                    else if (tileElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE &&
+                             !(tileElement->properties.entrance.index & 0x0F))
+                    {
+                        type = MAP_ANIMATION_TYPE_PARK_ENTRANCE;
+                    }
+                    break;
+                case TILE_ELEMENT_TYPE_PATH:
+                    if (footpath_element_is_queue(tileElement) && footpath_element_has_queue_banner(tileElement))
+                    {
+                        type = MAP_ANIMATION_TYPE_QUEUE_BANNER;
+                    }
+                    break;
+                case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                {
+                    rct_scenery_entry * sceneryEntry = get_small_scenery_entry(tileElement->properties.scenery.type);
+                    if (sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_ANIMATED))
+                    {
+                        type = MAP_ANIMATION_TYPE_SMALL_SCENERY;
+                    }
+                    break;
+                }
+                case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                {
+                    rct_scenery_entry * sceneryEntry = get_large_scenery_entry(tileElement->properties.scenery.type & 0x3FF);
+                    if (sceneryEntry != nullptr && (sceneryEntry->large_scenery.flags & LARGE_SCENERY_FLAG_ANIMATED))
+                    {
+                        type = MAP_ANIMATION_TYPE_LARGE_SCENERY;
+                    }
+                    break;
+                }
+                case TILE_ELEMENT_TYPE_WALL:
+                {
+                    rct_scenery_entry * sceneryEntry = get_wall_entry(tileElement->properties.scenery.type);
+                    if (sceneryEntry != nullptr &&
+                        ((sceneryEntry->wall.flags2 & WALL_SCENERY_2_ANIMATED) || sceneryEntry->wall.scrolling_mode != 255))
+                    {
+                        type = MAP_ANIMATION_TYPE_WALL;
+                    }
+                    if (sceneryEntry != nullptr && (sceneryEntry->wall.flags & WALL_SCENERY_IS_DOOR) &&
+                        wall_element_get_animation_frame(tileElement) != 0)
+                    {
+                        activeType = MAP_ANIMATION_TYPE_WALL_DOOR;
+                    }
+                    break;
+                }
+                case TILE_ELEMENT_TYPE_BANNER:
+                    type = MAP_ANIMATION_TYPE_BANNER;
+                    break;
+                case TILE_ELEMENT_TYPE_TRACK:
+                    switch (track_element_get_type(tileElement))
+                    {
+                    case TRACK_ELEM_WATERFALL:
+                        type = MAP_ANIMATION_TYPE_TRACK_WATERFALL;
+                        break;
+                    case TRACK_ELEM_RAPIDS:
+                        type = MAP_ANIMATION_TYPE_TRACK_RAPIDS;
+                        break;
+                    case TRACK_ELEM_WHIRLPOOL:
+                        type = MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL;
+                        break;
+                    case TRACK_ELEM_SPINNING_TUNNEL:
+                        type = MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL;
+                        break;
+                    case TRACK_ELEM_ON_RIDE_PHOTO:
+                        if (tile_element_is_taking_photo(tileElement))
+                        {
+                            activeType = MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO;
+                        }
+                        break;
+                    }
+                    break;
+                }
+
+                if (type != -1)
+                {
+                    map_animation_create(type, x * 32, y * 32, tileElement->base_height);
+                }
+                if (activeType != -1)
+                {
+                    map_animation_create(activeType, x * 32, y * 32, tileElement->base_height);
+                }
+            }
+            while (!tile_element_is_last_for_tile(tileElement++));
         }
     }
 }
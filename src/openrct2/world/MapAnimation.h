@@ -51,12 +51,11 @@ enum {
     MAP_ANIMATION_TYPE_COUNT
 };
 
-#define MAX_ANIMATED_OBJECTS 2000
-
-extern uint16 gNumMapAnimations;
-extern rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
-
 void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z);
 void map_animation_invalidate_all();
+void map_animation_clear();
+size_t map_animation_get_count();
+size_t map_animation_get_all(rct_map_animation * animations, size_t capacity);
+void map_animation_auto_create();
 
 #endif
@@ -14,6 +14,8 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
+#include <map>
 #include "../Cheats.h"
 #include "../config/Config.h"
 #include "../core/Math.hpp"
@@ -78,6 +80,27 @@ sint32 _suggestedGuestMaximum;
  */
 sint32 _guestGenerationProbability;
 
+/**
+ * When set, calculate_park_rating compares the incrementally maintained guest and litter counts with
+ * a full scan of the sprites and logs any difference.
+ */
+bool gParkVerifyRatingAggregates = false;
+
+// Guest and litter counts used by calculate_park_rating. They are updated whenever a guest or litter
+// changes, so the park rating does not have to scan every sprite.
+enum
+{
+    PARK_RATING_GUEST_HAPPY = 1 << 0,
+    PARK_RATING_GUEST_LOST  = 1 << 1,
+};
+static uint8 _parkRatingGuestFlags[MAX_SPRITES];
+static sint32 _parkRatingHappyGuests;
+static sint32 _parkRatingLostGuests;
+
+// Number of litter sprites per creation tick
+static std::map<uint32, uint16> _parkRatingLitterTicks;
+static sint32 _parkRatingLitterCount;
+
 sint32 park_is_open()
 {
     return (gParkFlags & PARK_FLAGS_PARK_OPEN) != 0;
@@ -189,6 +212,181 @@ sint32 park_calculate_size()
     return tiles;
 }
 
+static uint8 park_rating_get_guest_flags(const rct_peep * peep)
+{
+    if (peep->sprite_identifier != SPRITE_IDENTIFIER_PEEP || peep->type != PEEP_TYPE_GUEST)
+        return 0;
+    if (peep->outside_of_park != 0)
+        return 0;
+
+    uint8 flags = 0;
+    if (peep->happiness > 128)
+        flags |= PARK_RATING_GUEST_HAPPY;
+    if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
+        flags |= PARK_RATING_GUEST_LOST;
+    return flags;
+}
+
+static void park_rating_set_guest_flags(uint16 spriteIndex, uint8 flags)
+{
+    uint8 oldFlags = _parkRatingGuestFlags[spriteIndex];
+    if ((flags ^ oldFlags) & PARK_RATING_GUEST_HAPPY)
+        _parkRatingHappyGuests += (flags & PARK_RATING_GUEST_HAPPY) ? 1 : -1;
+    if ((flags ^ oldFlags) & PARK_RATING_GUEST_LOST)
+        _parkRatingLostGuests += (flags & PARK_RATING_GUEST_LOST) ? 1 : -1;
+    _parkRatingGuestFlags[spriteIndex] = flags;
+}
+
+static void park_rating_add_litter_tick(uint32 creationTick)
+{
+    _parkRatingLitterTicks[creationTick]++;
+    _parkRatingLitterCount++;
+}
+
+static void park_rating_remove_litter_tick(uint32 creationTick)
+{
+    auto it = _parkRatingLitterTicks.find(creationTick);
+    if (it == _parkRatingLitterTicks.end())
+        return;
+
+    if (--it->second == 0)
+        _parkRatingLitterTicks.erase(it);
+    _parkRatingLitterCount--;
+}
+
+/**
+ * Counts the litter that affects the park rating. Recently dropped litter, i.e. litter where
+ * creationTick - gScenarioTicks < 7680, is ignored.
+ */
+static sint32 park_rating_count_litter()
+{
+    uint32 recentBegin = gScenarioTicks;
+    uint32 recentEnd = gScenarioTicks + 7680;
+
+    sint32 numRecent = 0;
+    auto it = _parkRatingLitterTicks.lower_bound(recentBegin);
+    for (; it != _parkRatingLitterTicks.end() && (recentBegin > recentEnd || it->first < recentEnd); it++)
+        numRecent += it->second;
+    if (recentBegin > recentEnd)
+    {
+        // The range wraps around
+        for (it = _parkRatingLitterTicks.begin(); it != _parkRatingLitterTicks.end() && it->first < recentEnd; it++)
+            numRecent += it->second;
+    }
+    return _parkRatingLitterCount - numRecent;
+}
+
+/**
+ * Recounts the guests and litter used by the park rating from the sprite lists. Must be called
+ * whenever sprites have been written to directly, e.g. after loading a park.
+ */
+void park_rating_reset_aggregates()
+{
+    std::fill_n(_parkRatingGuestFlags, MAX_SPRITES, 0);
+    _parkRatingHappyGuests = 0;
+    _parkRatingLostGuests = 0;
+    _parkRatingLitterTicks.clear();
+    _parkRatingLitterCount = 0;
+
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        park_rating_guest_changed(peep);
+    }
+
+    rct_litter * litter;
+    for (spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
+    {
+        litter = &(get_sprite(spriteIndex)->litter);
+        park_rating_add_litter_tick(litter->creationTick);
+    }
+}
+
+/**
+ * Updates the park rating counts after any field of a guest that affects them has changed, i.e.
+ * happiness, outside_of_park, peep_flags or peep_is_lost_countdown.
+ */
+void park_rating_guest_changed(const rct_peep * peep)
+{
+    if (peep->sprite_index < MAX_SPRITES)
+    {
+        park_rating_set_guest_flags(peep->sprite_index, park_rating_get_guest_flags(peep));
+    }
+}
+
+void park_rating_litter_created(const rct_litter * litter)
+{
+    park_rating_add_litter_tick(litter->creationTick);
+}
+
+/**
+ * Must be called before the sprite is removed from its list.
+ */
+void park_rating_sprite_removed(const rct_sprite * sprite)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    if (spriteIndex >= MAX_SPRITES)
+        return;
+
+    park_rating_set_guest_flags(spriteIndex, 0);
+    if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+    {
+        park_rating_remove_litter_tick(sprite->litter.creationTick);
+    }
+}
+
+/**
+ * Compares the guest counts with a full scan, on a mismatch the counts are corrected and rebuilt.
+ */
+static void park_rating_verify_guests(sint32 &numHappyGuests, sint32 &numLostGuests)
+{
+    uint16 spriteIndex;
+    rct_peep * peep;
+    sint32 expectedHappyGuests = 0;
+    sint32 expectedLostGuests = 0;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->outside_of_park != 0)
+            continue;
+        if (peep->happiness > 128)
+            expectedHappyGuests++;
+        if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
+            expectedLostGuests++;
+    }
+
+    if (numHappyGuests != expectedHappyGuests || numLostGuests != expectedLostGuests)
+    {
+        log_error("Park rating guest counts out of sync: happy %d (expected %d), lost %d (expected %d)",
+            numHappyGuests, expectedHappyGuests, numLostGuests, expectedLostGuests);
+        numHappyGuests = expectedHappyGuests;
+        numLostGuests = expectedLostGuests;
+        park_rating_reset_aggregates();
+    }
+}
+
+static void park_rating_verify_litter(sint16 &numLitter)
+{
+    uint16 spriteIndex;
+    rct_litter * litter;
+    sint32 expectedLitter = 0;
+    for (spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
+    {
+        litter = &(get_sprite(spriteIndex)->litter);
+
+        // Ignore recently dropped litter
+        if (litter->creationTick - gScenarioTicks >= 7680)
+            expectedLitter++;
+    }
+
+    if (numLitter != expectedLitter)
+    {
+        log_error("Park rating litter count out of sync: %d (expected %d)", numLitter, expectedLitter);
+        numLitter = (sint16)expectedLitter;
+        park_rating_reset_aggregates();
+    }
+}
+
 /**
  *
  *  rct2: 0x00669EAA
@@ -206,26 +404,16 @@ sint32 calculate_park_rating()
 
     // Guests
     {
-        rct_peep* peep;
-        uint16 spriteIndex;
-        sint32 num_happy_peeps;
-        sint32 num_lost_guests;
+        sint32 num_happy_peeps = _parkRatingHappyGuests;
+        sint32 num_lost_guests = _parkRatingLostGuests;
+        if (gParkVerifyRatingAggregates)
+        {
+            park_rating_verify_guests(num_happy_peeps, num_lost_guests);
+        }
 
         // -150 to +3 based on a range of guests from 0 to 2000
         result -= 150 - (Math::Min((uint16)2000, gNumGuestsInPark) / 13);
 
-        // Find the number of happy peeps and the number of peeps who can't find the park exit
-        num_happy_peeps = 0;
-        num_lost_guests = 0;
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (peep->happiness > 128)
-                num_happy_peeps++;
-            if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
-                num_lost_guests++;
-        }
-
         // Peep happiness -500 to +0
         result -= 500;
 
@@ -292,17 +480,10 @@ sint32 calculate_park_rating()
 
     // Litter
     {
-        rct_litter* litter;
-        uint16 sprite_idx;
-        sint16 num_litter;
-
-        num_litter = 0;
-        for (sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next) {
-            litter = &(get_sprite(sprite_idx)->litter);
-
-            // Ignore recently dropped litter
-            if (litter->creationTick - gScenarioTicks >= 7680)
-                num_litter++;
+        sint16 num_litter = (sint16)park_rating_count_litter();
+        if (gParkVerifyRatingAggregates)
+        {
+            park_rating_verify_litter(num_litter);
         }
         result -= 600 - (4 * (150 - Math::Min((sint16)150, num_litter)));
     }
@@ -24,7 +24,9 @@
 
 #define MAX_ENTRANCE_FEE MONEY(200,00)
 
+struct rct_litter;
 struct rct_peep;
+union rct_sprite;
 
 enum {
     PARK_FLAGS_PARK_OPEN = (1 << 0),
@@ -79,6 +81,7 @@ extern uint8 gParkRatingHistory[32];
 extern uint8 gGuestsInParkHistory[32];
 extern sint32 _guestGenerationProbability;
 extern sint32 _suggestedGuestMaximum;
+extern bool gParkVerifyRatingAggregates;
 
 void set_forced_park_rating(sint32 rating);
 sint32 get_forced_park_rating();
@@ -89,6 +92,10 @@ void park_reset_history();
 sint32 park_calculate_size();
 
 sint32 calculate_park_rating();
+void park_rating_reset_aggregates();
+void park_rating_guest_changed(const rct_peep * peep);
+void park_rating_litter_created(const rct_litter * litter);
+void park_rating_sprite_removed(const rct_sprite * sprite);
 money32 calculate_park_value();
 money32 calculate_company_value();
 void reset_park_entry();
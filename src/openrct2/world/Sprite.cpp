@@ -26,7 +26,9 @@
 #include "../OpenRCT2.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "Park.h"
 #include "Sprite.h"
+#include "SpriteSpatialGrid.hpp"
 
 uint16 gSpriteListHead[6];
 uint16 gSpriteListCount[6];
@@ -58,6 +60,13 @@ static LocationXYZ16 _spritelocations2[MAX_SPRITES];
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y);
 
+// Peeps are additionally bucketed in 4x4 tile cells for neighbour queries
+static SpriteSpatialGrid<7> _peepSpatialGrid;
+
+// Litter is bucketed in 2x2 tile cells for the handyman and guest litter queries
+static SpriteSpatialGrid<6> _litterSpatialGrid;
+static std::vector<uint16> _litterQueryResults;
+
 rct_sprite *try_get_sprite(size_t spriteIndex)
 {
     rct_sprite * sprite = nullptr;
@@ -186,6 +195,48 @@ void reset_sprite_spatial_index()
             spr->unknown.next_in_quadrant = nextSpriteId;
         }
     }
+
+    reset_peep_spatial_index();
+}
+
+/**
+ * Rebuilds the peep and litter grids and the park rating counts from the sprite pool. None of
+ * them are part of the saved game state, so this must be called whenever sprites have been
+ * written to directly, e.g. after loading a park.
+ */
+void reset_peep_spatial_index()
+{
+    _peepSpatialGrid.Clear();
+    _litterSpatialGrid.Clear();
+    for (size_t i = 0; i < MAX_SPRITES; i++) {
+        rct_sprite *spr = get_sprite(i);
+        if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+            _peepSpatialGrid.Move(spr->unknown.sprite_index, spr->unknown.x, spr->unknown.y);
+        } else if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER) {
+            _litterSpatialGrid.Move(spr->unknown.sprite_index, spr->unknown.x, spr->unknown.y);
+        }
+    }
+
+    park_rating_reset_aggregates();
+}
+
+/**
+ * Gets all peeps within the given square of map coordinates, in ascending sprite index order.
+ * The result may contain peeps slightly outside the square, callers must do their own
+ * distance checks.
+ */
+void peep_spatial_index_query(sint32 x, sint32 y, sint32 radius, std::vector<uint16> &results)
+{
+    _peepSpatialGrid.QueryRadius(x, y, radius, results);
+}
+
+/**
+ * Gets all peeps in the cells overlapping the given inclusive map rectangle, in ascending sprite
+ * index order. Peeps near the edges may lie outside the rectangle.
+ */
+void peep_spatial_index_query_rect(sint32 left, sint32 top, sint32 right, sint32 bottom, std::vector<uint16> &results)
+{
+    _peepSpatialGrid.QueryRect(left, top, right, bottom, results);
 }
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
@@ -206,48 +257,75 @@ static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
 
 #ifndef DISABLE_NETWORK
 
-static uint8 _spriteChecksum[EVP_MAX_MD_SIZE + 1];
+static char _spriteChecksum[17];
+static uint32 _spriteChecksumRanges[SPRITE_CHECKSUM_RANGE_COUNT];
 
-const char * sprite_checksum()
+static constexpr uint64 SPRITE_HASH_PRIME = 0x100000001B3ULL;
+static constexpr uint64 SPRITE_HASH_MIX = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * Hashes the game state of a single sprite, leaving out fields that only affect rendering or
+ * the UI. This is a fast non-cryptographic hash, it only needs to detect accidental differences.
+ */
+static uint64 sprite_hash(const rct_sprite * sprite)
 {
-    if (EVP_DigestInit_ex(gHashCTX, EVP_sha1(), NULL) <= 0)
+    static_assert(sizeof(rct_sprite) % sizeof(uint64) == 0, "Sprite size must be a multiple of 8");
+
+    rct_sprite copy = *sprite;
+    copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+
+    if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
+        copy.peep.window_invalidate_flags = 0;
+    }
+
+    uint64 words[sizeof(rct_sprite) / sizeof(uint64)];
+    memcpy(words, &copy, sizeof(rct_sprite));
+
+    uint64 hash = SPRITE_HASH_MIX ^ sprite->unknown.sprite_index;
+    for (uint64 word : words)
     {
-        openrct2_assert(false, "Failed to initialise SHA1 engine");
+        word *= SPRITE_HASH_MIX;
+        word ^= word >> 32;
+        hash = (hash ^ word) * SPRITE_HASH_PRIME;
     }
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    return hash;
+}
+
+/**
+ * Computes a checksum of all game relevant sprites. Sprites are hashed individually and combined
+ * per range of SPRITE_CHECKSUM_RANGE_SIZE sprites, the range hashes are then combined into the
+ * returned digest. The range hashes are kept so that a desync can be narrowed down to a range.
+ */
+const char * sprite_checksum()
+{
+    uint64 digest = SPRITE_HASH_MIX;
+    for (size_t range = 0; range < SPRITE_CHECKSUM_RANGE_COUNT; range++)
     {
-        rct_sprite *sprite = get_sprite(i);
-        if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
+        uint64 rangeHash = SPRITE_HASH_MIX ^ range;
+        size_t rangeStart = range * SPRITE_CHECKSUM_RANGE_SIZE;
+        for (size_t i = rangeStart; i < rangeStart + SPRITE_CHECKSUM_RANGE_SIZE; i++)
         {
-            rct_sprite copy = *sprite;
-            copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
-
-            if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
-                // We set this to 0 because as soon the client selects a guest the window will remove the
-                // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
-                copy.peep.window_invalidate_flags = 0;
-            }
-
-            if (EVP_DigestUpdate(gHashCTX, &copy, sizeof(rct_sprite)) <= 0)
+            uint8 identifier = _spriteList[i].unknown.sprite_identifier;
+            if (identifier != SPRITE_IDENTIFIER_NULL && identifier != SPRITE_IDENTIFIER_MISC)
             {
-                openrct2_assert(false, "Failed to update digest");
+                rangeHash = (rangeHash ^ sprite_hash(&_spriteList[i])) * SPRITE_HASH_PRIME;
             }
         }
+        _spriteChecksumRanges[range] = (uint32)(rangeHash ^ (rangeHash >> 32));
+        digest = (digest ^ rangeHash) * SPRITE_HASH_PRIME;
     }
-    uint8 localhash[EVP_MAX_MD_SIZE + 1];
-    uint32 size = sizeof(localhash);
-    EVP_DigestFinal(gHashCTX, localhash, &size);
-    assert(size <= sizeof(localhash));
-    localhash[sizeof(localhash) - 1] = '\0';
-    char *x = (char *)_spriteChecksum;
-    for (uint32 i = 0; i < size; i++)
-    {
-        snprintf(x, EVP_MAX_MD_SIZE + 1, "%02x", localhash[i]);
-        x += 2;
-    }
-    *x = '\0';
-    return (char *)_spriteChecksum;
+
+    snprintf(_spriteChecksum, sizeof(_spriteChecksum), "%08x%08x", (uint32)(digest >> 32), (uint32)digest);
+    return _spriteChecksum;
+}
+
+const uint32 * sprite_checksum_ranges()
+{
+    return _spriteChecksumRanges;
 }
+
 #else
 
 const char * sprite_checksum()
@@ -255,6 +333,11 @@ const char * sprite_checksum()
     return nullptr;
 }
 
+const uint32 * sprite_checksum_ranges()
+{
+    return nullptr;
+}
+
 #endif // DISABLE_NETWORK
 
 static void sprite_reset(rct_unk_sprite *sprite)
@@ -577,6 +660,12 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
         sprite->unknown.next_in_quadrant = tempSpriteIndex;
     }
 
+    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        _peepSpatialGrid.Move(sprite->unknown.sprite_index, x, y);
+    } else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER) {
+        _litterSpatialGrid.Move(sprite->unknown.sprite_index, x, y);
+    }
+
     if (x == LOCATION_NULL) {
         sprite->unknown.sprite_left = LOCATION_NULL;
         sprite->unknown.x = x;
@@ -623,10 +712,13 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+    park_rating_sprite_removed(sprite);
     move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
     user_string_free(sprite->unknown.name_string_idx);
     sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->unknown.sprite_index] = false;
+    _peepSpatialGrid.Remove(sprite->unknown.sprite_index);
+    _litterSpatialGrid.Remove(sprite->unknown.sprite_index);
 
     size_t quadrantIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
     uint16 *spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
@@ -709,6 +801,7 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
     sprite_move(x, y, z, (rct_sprite*)litter);
     invalidate_sprite_0((rct_sprite*)litter);
     litter->creationTick = gScenarioTicks;
+    park_rating_litter_created(litter);
 }
 
 /**
@@ -735,6 +828,70 @@ void litter_remove_at(sint32 x, sint32 y, sint32 z)
     }
 }
 
+static uint16 litter_get_distance(const rct_litter * litter, sint32 x, sint32 y, sint32 z)
+{
+    return abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+}
+
+/**
+ * Gets the litter closest to the given position, where z differences count four times, or nullptr
+ * if there is none within maxDistance. Equally close litter is resolved the same way as scanning
+ * the litter list and taking the first, except that litter on the same tile is interchangeable.
+ */
+rct_litter * litter_get_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance)
+{
+    _litterSpatialGrid.QueryRadius(x, y, maxDistance, _litterQueryResults);
+
+    rct_litter * nearestLitter = nullptr;
+    uint16 nearestDistance = 0;
+    bool tiedOnOtherTile = false;
+    for (uint16 spriteIndex : _litterQueryResults) {
+        rct_litter * litter = &get_sprite(spriteIndex)->litter;
+        uint16 distance = litter_get_distance(litter, x, y, z);
+        if (distance > maxDistance)
+            continue;
+
+        if (nearestLitter == nullptr || distance < nearestDistance) {
+            nearestLitter = litter;
+            nearestDistance = distance;
+            tiedOnOtherTile = false;
+        } else if (distance == nearestDistance) {
+            if (((litter->x ^ nearestLitter->x) & 0xFFE0) || ((litter->y ^ nearestLitter->y) & 0xFFE0)) {
+                tiedOnOtherTile = true;
+            }
+        }
+    }
+
+    if (tiedOnOtherTile) {
+        // The grid returns litter in sprite index order, only the list order decides between tiles
+        rct_litter * litter;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next) {
+            litter = &get_sprite(spriteIndex)->litter;
+            if (litter_get_distance(litter, x, y, z) == nearestDistance) {
+                return litter;
+            }
+        }
+    }
+    return nearestLitter;
+}
+
+/**
+ * Counts the litter whose x and y are both within range of the given map coordinates.
+ */
+sint32 litter_count_in_range(sint32 x, sint32 y, sint32 range)
+{
+    _litterSpatialGrid.QueryRadius(x, y, range, _litterQueryResults);
+
+    sint32 count = 0;
+    for (uint16 spriteIndex : _litterQueryResults) {
+        const rct_litter * litter = &get_sprite(spriteIndex)->litter;
+        if (abs(litter->x - x) <= range && abs(litter->y - y) <= range) {
+            count++;
+        }
+    }
+    return count;
+}
+
 /**
  * Determines whether it's worth tweening a sprite or not when frame smoothing is on.
  */
@@ -17,6 +17,7 @@
 #ifndef _SPRITE_H_
 #define _SPRITE_H_
 
+#include <vector>
 #include "../common.h"
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
@@ -391,6 +392,7 @@ extern const rct_string_id litterNames[12];
 rct_sprite *create_sprite(uint8 bl);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
+void reset_peep_spatial_index();
 void sprite_clear_all_unused();
 void move_sprite_to_list(rct_sprite *sprite, uint8 cl);
 void sprite_misc_update_all();
@@ -402,9 +404,13 @@ void invalidate_sprite_2(rct_sprite *sprite);
 void sprite_remove(rct_sprite *sprite);
 void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type);
 void litter_remove_at(sint32 x, sint32 y, sint32 z);
+rct_litter * litter_get_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance);
+sint32 litter_count_in_range(sint32 x, sint32 y, sint32 range);
 void sprite_misc_explosion_cloud_create(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_flare_create(sint32 x, sint32 y, sint32 z);
 uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y);
+void peep_spatial_index_query(sint32 x, sint32 y, sint32 radius, std::vector<uint16> &results);
+void peep_spatial_index_query_rect(sint32 left, sint32 top, sint32 right, sint32 bottom, std::vector<uint16> &results);
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -443,7 +449,11 @@ void crashed_vehicle_particle_update(rct_crashed_vehicle_particle *particle);
 void crash_splash_create(sint32 x, sint32 y, sint32 z);
 void crash_splash_update(rct_crash_splash *splash);
 
+#define SPRITE_CHECKSUM_RANGE_SIZE  250
+#define SPRITE_CHECKSUM_RANGE_COUNT (MAX_SPRITES / SPRITE_CHECKSUM_RANGE_SIZE)
+
 const char *sprite_checksum();
+const uint32 *sprite_checksum_ranges();
 
 void sprite_set_flashing(rct_sprite *sprite, bool flashing);
 bool sprite_get_flashing(rct_sprite *sprite);
@@ -0,0 +1,165 @@
+#pragma region Copyright (c) 2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "../common.h"
+#include "../core/Math.hpp"
+#include "Location.hpp"
+#include "Sprite.h"
+
+/**
+ * Buckets a subset of sprites by map position so that neighbour queries only need to visit
+ * the cells overlapping the search area instead of the whole sprite list. Each cell stores
+ * its sprite indices contiguously, removal swaps with the last entry of the cell.
+ *
+ * Query results are sorted by sprite index, so they do not depend on the order in which sprites
+ * entered their cells. This is not the order of a FOR_ALL_* loop, which follows the sprite linked
+ * list. Callers must only use queries where the outcome does not depend on iteration order.
+ */
+template<sint32 TCellShift>
+class SpriteSpatialGrid
+{
+private:
+    static constexpr sint32 MAP_COORD_LIMIT = 0x2000;
+    static constexpr sint32 CELLS_PER_SIDE = MAP_COORD_LIMIT >> TCellShift;
+    static constexpr uint16 CELL_NULL = 0xFFFF;
+
+    static_assert(CELLS_PER_SIDE * CELLS_PER_SIDE < CELL_NULL, "Too many cells for SpriteSpatialGrid");
+
+    std::vector<uint16> _cells[CELLS_PER_SIDE * CELLS_PER_SIDE];
+    uint16              _cellOf[MAX_SPRITES];
+    uint16              _slotOf[MAX_SPRITES];
+    size_t              _count = 0;
+
+public:
+    SpriteSpatialGrid()
+    {
+        std::fill_n(_cellOf, MAX_SPRITES, (uint16)CELL_NULL);
+    }
+
+    void Clear()
+    {
+        for (auto &cell : _cells)
+        {
+            cell.clear();
+        }
+        std::fill_n(_cellOf, MAX_SPRITES, (uint16)CELL_NULL);
+        _count = 0;
+    }
+
+    size_t GetCount() const
+    {
+        return _count;
+    }
+
+    bool Contains(uint16 spriteIndex) const
+    {
+        return spriteIndex < MAX_SPRITES && _cellOf[spriteIndex] != CELL_NULL;
+    }
+
+    /**
+     * Inserts or moves a sprite to the cell containing the given position. A position of
+     * LOCATION_NULL removes the sprite from the grid.
+     */
+    void Move(uint16 spriteIndex, sint32 x, sint32 y)
+    {
+        if (spriteIndex >= MAX_SPRITES)
+        {
+            return;
+        }
+        if (x == LOCATION_NULL)
+        {
+            Remove(spriteIndex);
+            return;
+        }
+
+        uint16 cellIndex = GetCellIndex(x, y);
+        if (_cellOf[spriteIndex] == cellIndex)
+        {
+            return;
+        }
+
+        Remove(spriteIndex);
+
+        auto &cell = _cells[cellIndex];
+        _cellOf[spriteIndex] = cellIndex;
+        _slotOf[spriteIndex] = (uint16)cell.size();
+        cell.push_back(spriteIndex);
+        _count++;
+    }
+
+    void Remove(uint16 spriteIndex)
+    {
+        if (!Contains(spriteIndex))
+        {
+            return;
+        }
+
+        auto &cell = _cells[_cellOf[spriteIndex]];
+        uint16 slot = _slotOf[spriteIndex];
+        uint16 last = cell.back();
+        cell[slot] = last;
+        _slotOf[last] = slot;
+        cell.pop_back();
+
+        _cellOf[spriteIndex] = CELL_NULL;
+        _count--;
+    }
+
+    /**
+     * Appends to results all sprites whose cell overlaps the given inclusive map rectangle.
+     * Sprites near the edges may lie outside the rectangle, callers still apply their exact
+     * distance test.
+     */
+    void QueryRect(sint32 left, sint32 top, sint32 right, sint32 bottom, std::vector<uint16> &results) const
+    {
+        results.clear();
+        if (right < 0 || bottom < 0 || left >= MAP_COORD_LIMIT || top >= MAP_COORD_LIMIT)
+        {
+            return;
+        }
+
+        sint32 cellLeft = Math::Clamp(0, left, MAP_COORD_LIMIT - 1) >> TCellShift;
+        sint32 cellTop = Math::Clamp(0, top, MAP_COORD_LIMIT - 1) >> TCellShift;
+        sint32 cellRight = Math::Clamp(0, right, MAP_COORD_LIMIT - 1) >> TCellShift;
+        sint32 cellBottom = Math::Clamp(0, bottom, MAP_COORD_LIMIT - 1) >> TCellShift;
+        for (sint32 cx = cellLeft; cx <= cellRight; cx++)
+        {
+            for (sint32 cy = cellTop; cy <= cellBottom; cy++)
+            {
+                const auto &cell = _cells[cx * CELLS_PER_SIDE + cy];
+                results.insert(results.end(), cell.begin(), cell.end());
+            }
+        }
+        std::sort(results.begin(), results.end());
+    }
+
+    void QueryRadius(sint32 x, sint32 y, sint32 radius, std::vector<uint16> &results) const
+    {
+        QueryRect(x - radius, y - radius, x + radius, y + radius, results);
+    }
+
+private:
+    static uint16 GetCellIndex(sint32 x, sint32 y)
+    {
+        sint32 cx = Math::Clamp(0, x, MAP_COORD_LIMIT - 1) >> TCellShift;
+        sint32 cy = Math::Clamp(0, y, MAP_COORD_LIMIT - 1) >> TCellShift;
+        return (uint16)(cx * CELLS_PER_SIDE + cy);
+    }
+};
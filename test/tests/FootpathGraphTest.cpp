@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+
+class FootpathGraphTest : public testing::Test
+{
+protected:
+    static constexpr uint8 PATH_HEIGHT = 14;
+
+    std::vector<std::pair<sint32, sint32>> _paths;
+
+    void SetUp() override
+    {
+        // A flat map without any paths, the same surface map_init creates
+        for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+        {
+            rct_tile_element * tileElement = &gTileElements[i];
+            *tileElement = {};
+            tileElement->type = TILE_ELEMENT_TYPE_SURFACE;
+            tileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement->base_height = PATH_HEIGHT;
+            tileElement->clearance_height = PATH_HEIGHT;
+        }
+        map_update_tile_pointers();
+        _paths.clear();
+    }
+
+    static rct_tile_element * GetPath(sint32 x, sint32 y)
+    {
+        rct_tile_element * tileElement = map_get_first_element_at(x, y);
+        do
+        {
+            if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH)
+                return tileElement;
+        }
+        while (!tile_element_is_last_for_tile(tileElement++));
+        return nullptr;
+    }
+
+    bool HasPath(sint32 x, sint32 y) const
+    {
+        return std::find(_paths.begin(), _paths.end(), std::make_pair(x, y)) != _paths.end();
+    }
+
+    /**
+     * Places flat paths on the given tiles and connects every path to the paths next to it.
+     */
+    void PlacePaths(const std::vector<std::pair<sint32, sint32>> &tiles)
+    {
+        for (const auto &tile : tiles)
+        {
+            rct_tile_element * path = tile_element_insert(tile.first, tile.second, PATH_HEIGHT, 0x0F);
+            ASSERT_NE(path, nullptr);
+            path->type = TILE_ELEMENT_TYPE_PATH;
+            path->clearance_height = PATH_HEIGHT + 4;
+            _paths.push_back(tile);
+        }
+        for (const auto &tile : _paths)
+        {
+            uint8 edges = 0;
+            for (sint32 direction = 0; direction < 4; direction++)
+            {
+                if (HasPath(tile.first + TileDirectionDelta[direction].x / 32, tile.second + TileDirectionDelta[direction].y / 32))
+                {
+                    edges |= 1 << direction;
+                }
+            }
+            GetPath(tile.first, tile.second)->properties.path.edges = edges;
+        }
+    }
+
+    static sint32 ChooseDirection(sint32 x, sint32 y, sint32 goalX, sint32 goalY, uint8 edges = 0x0F)
+    {
+        LocationXYZ16 goal = { (sint16)(goalX * 32), (sint16)(goalY * 32), PATH_HEIGHT };
+        return footpath_graph_choose_direction(x, y, PATH_HEIGHT, edges, goal, 0xFF, false);
+    }
+
+    /**
+     * A straight path from (10, 10) to (14, 10), a longer detour around it through y = 8 and a
+     * dead end leaving the straight path at (12, 10).
+     */
+    void PlaceJunctions()
+    {
+        PlacePaths({ { 10, 10 }, { 11, 10 }, { 12, 10 }, { 13, 10 }, { 14, 10 } });
+        PlacePaths({ { 10, 9 }, { 10, 8 }, { 11, 8 }, { 12, 8 }, { 13, 8 }, { 14, 8 }, { 14, 9 } });
+        PlacePaths({ { 12, 11 }, { 12, 12 } });
+    }
+};
+
+TEST_F(FootpathGraphTest, ChoosesShortestRouteAtJunctions)
+{
+    PlaceJunctions();
+
+    // Direction 2 is +x, direction 3 is -y
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10, 1 << 3), 3);
+    EXPECT_EQ(ChooseDirection(14, 8, 14, 10), 1);
+    EXPECT_EQ(ChooseDirection(12, 12, 14, 10), 3);
+    EXPECT_EQ(ChooseDirection(12, 10, 12, 12), 1);
+}
+
+TEST_F(FootpathGraphTest, UnreachableGoal)
+{
+    PlaceJunctions();
+    PlacePaths({ { 30, 30 } });
+
+    EXPECT_EQ(ChooseDirection(10, 10, 30, 30), -1);
+    EXPECT_EQ(ChooseDirection(10, 10, 40, 40), -1);
+    EXPECT_EQ(ChooseDirection(40, 40, 10, 10), -1);
+}
+
+TEST_F(FootpathGraphTest, RemovedPathIsInvalidated)
+{
+    PlaceJunctions();
+    ASSERT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+
+    // The neighbours keep their edges towards the removed path
+    tile_element_remove(GetPath(12, 10));
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 3);
+    EXPECT_EQ(ChooseDirection(12, 12, 14, 10), -1);
+}
+
+TEST_F(FootpathGraphTest, InsertedPathIsInvalidated)
+{
+    PlacePaths({ { 10, 10 }, { 14, 10 } });
+    PlacePaths({ { 10, 9 }, { 10, 8 }, { 11, 8 }, { 12, 8 }, { 13, 8 }, { 14, 8 }, { 14, 9 } });
+    ASSERT_EQ(ChooseDirection(10, 10, 14, 10), 3);
+
+    // Connecting the new paths changes the edges of both ends, which the footpath code invalidates
+    PlacePaths({ { 11, 10 }, { 12, 10 }, { 13, 10 } });
+    footpath_graph_invalidate_tile(10, 10);
+    footpath_graph_invalidate_tile(14, 10);
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+}
+
+TEST_F(FootpathGraphTest, GoalsAreCachedUntilInvalidated)
+{
+    PlaceJunctions();
+    ASSERT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+
+    // Changes the map without invalidating the tile, the graph and the cached distances are kept
+    GetPath(11, 10)->properties.path.edges = 0;
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+
+    footpath_graph_invalidate_tile(11, 10);
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 3);
+}
+
+TEST_F(FootpathGraphTest, GoalCacheIsRecycled)
+{
+    std::vector<std::pair<sint32, sint32>> tiles;
+    for (sint32 x = 1; x < 250; x++)
+    {
+        tiles.emplace_back(x, 20);
+    }
+    PlacePaths(tiles);
+
+    // More goals than the cache holds, each one both ways
+    for (sint32 x = 2; x < 249; x++)
+    {
+        EXPECT_EQ(ChooseDirection(1, 20, x, 20), 2);
+        EXPECT_EQ(ChooseDirection(249, 20, x, 20), 0);
+    }
+    EXPECT_EQ(ChooseDirection(249, 20, 2, 20), 0);
+    EXPECT_EQ(ChooseDirection(1, 20, 248, 20), 2);
+}
+
+TEST_F(FootpathGraphTest, InvalidateRebuildsGraph)
+{
+    PlaceJunctions();
+    ASSERT_EQ(ChooseDirection(10, 10, 14, 10), 2);
+
+    GetPath(11, 10)->properties.path.edges = 0;
+    footpath_graph_invalidate();
+    EXPECT_EQ(ChooseDirection(10, 10, 14, 10), 3);
+}
@@ -0,0 +1,128 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+
+constexpr uint32 MAX_IMAGES = 262144;
+constexpr uint32 INVALID_IMAGE_ID = UINT32_MAX;
+
+class ImageAllocatorTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // The allocator is global, every test frees what it allocated
+        uint32 baseImageId = Allocate(1);
+        ASSERT_NE(baseImageId, INVALID_IMAGE_ID);
+        Free(baseImageId, 1);
+        ExpectAllFree();
+    }
+
+    void TearDown() override
+    {
+        ExpectAllFree();
+    }
+
+    static uint32 Allocate(uint32 count)
+    {
+        std::vector<rct_g1_element> images(count);
+        return gfx_object_allocate_images(images.data(), count);
+    }
+
+    static void Free(uint32 baseImageId, uint32 count)
+    {
+        gfx_object_free_images(baseImageId, count);
+    }
+
+    static void ExpectAllFree()
+    {
+        image_list_stats stats = gfx_object_get_image_list_stats();
+        EXPECT_EQ(stats.allocated_images, 0u);
+        EXPECT_EQ(stats.free_images, MAX_IMAGES);
+        EXPECT_EQ(stats.free_lists, 1u);
+        EXPECT_EQ(stats.largest_free_list, MAX_IMAGES);
+    }
+};
+
+TEST_F(ImageAllocatorTest, AllocateFreeReuse)
+{
+    uint32 a = Allocate(10);
+    uint32 b = Allocate(20);
+    ASSERT_NE(a, INVALID_IMAGE_ID);
+    EXPECT_EQ(b, a + 10);
+
+    image_list_stats stats = gfx_object_get_image_list_stats();
+    EXPECT_EQ(stats.allocated_images, 30u);
+    EXPECT_EQ(stats.free_images, MAX_IMAGES - 30);
+
+    // The smallest free list that fits is used, which is the one just freed
+    Free(a, 10);
+    EXPECT_EQ(gfx_object_get_image_list_stats().free_lists, 2u);
+    uint32 c = Allocate(5);
+    uint32 d = Allocate(5);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(d, a + 5);
+    EXPECT_EQ(gfx_object_get_image_list_stats().free_lists, 1u);
+
+    // Too big for the freed list, taken from the end
+    Free(c, 5);
+    uint32 e = Allocate(6);
+    EXPECT_EQ(e, b + 20);
+
+    Free(d, 5);
+    Free(b, 20);
+    Free(e, 6);
+}
+
+TEST_F(ImageAllocatorTest, MergesAdjacentFreeLists)
+{
+    uint32 a = Allocate(10);
+    uint32 b = Allocate(10);
+    uint32 c = Allocate(10);
+    uint32 d = Allocate(10);
+
+    Free(a, 10);
+    Free(c, 10);
+    image_list_stats stats = gfx_object_get_image_list_stats();
+    EXPECT_EQ(stats.free_lists, 3u);
+    EXPECT_EQ(stats.largest_free_list, MAX_IMAGES - 40);
+
+    // Joins the lists on both sides
+    Free(b, 10);
+    stats = gfx_object_get_image_list_stats();
+    EXPECT_EQ(stats.free_lists, 2u);
+    EXPECT_EQ(stats.free_images, MAX_IMAGES - 10);
+
+    uint32 e = Allocate(30);
+    EXPECT_EQ(e, a);
+    EXPECT_EQ(gfx_object_get_image_list_stats().free_lists, 1u);
+
+    // Joins the list before, then the list after
+    Free(e, 30);
+    Free(d, 10);
+}
+
+TEST_F(ImageAllocatorTest, FailsWhenExhausted)
+{
+    uint32 all = Allocate(MAX_IMAGES);
+    ASSERT_NE(all, INVALID_IMAGE_ID);
+    image_list_stats stats = gfx_object_get_image_list_stats();
+    EXPECT_EQ(stats.free_images, 0u);
+    EXPECT_EQ(stats.free_lists, 0u);
+    EXPECT_EQ(Allocate(1), INVALID_IMAGE_ID);
+    Free(all, MAX_IMAGES);
+
+    // Enough images are free in total, but not in one list
+    uint32 a = Allocate(10);
+    uint32 b = Allocate(10);
+    uint32 c = Allocate(10);
+    uint32 rest = Allocate(MAX_IMAGES - 30);
+    ASSERT_NE(rest, INVALID_IMAGE_ID);
+    Free(a, 10);
+    Free(c, 10);
+    EXPECT_EQ(gfx_object_get_image_list_stats().free_images, 20u);
+    EXPECT_EQ(Allocate(15), INVALID_IMAGE_ID);
+    EXPECT_EQ(gfx_object_get_image_list_stats().allocated_images, MAX_IMAGES - 20);
+
+    Free(b, 10);
+    Free(rest, MAX_IMAGES - 30);
+}
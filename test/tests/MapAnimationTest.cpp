@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/rct2/RCT2.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/MapAnimation.h>
+
+class MapAnimationTest : public testing::Test
+{
+protected:
+    static constexpr uint8 PATH_HEIGHT = 14;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+
+        // A flat map without anything on it
+        for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+        {
+            rct_tile_element * tileElement = &gTileElements[i];
+            *tileElement = {};
+            tileElement->type = TILE_ELEMENT_TYPE_SURFACE;
+            tileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement->base_height = PATH_HEIGHT;
+            tileElement->clearance_height = PATH_HEIGHT;
+        }
+        map_update_tile_pointers();
+        map_animation_clear();
+    }
+
+    static void PlaceQueueBanner(sint32 x, sint32 y)
+    {
+        rct_tile_element * path = tile_element_insert(x, y, PATH_HEIGHT, 0x0F);
+        ASSERT_NE(path, nullptr);
+        path->type = TILE_ELEMENT_TYPE_PATH;
+        path->clearance_height = PATH_HEIGHT + 4;
+        footpath_element_set_queue(path);
+        path->properties.path.type |= FOOTPATH_PROPERTIES_FLAG_HAS_QUEUE_BANNER;
+    }
+
+    static std::vector<rct_map_animation> GetAll()
+    {
+        std::vector<rct_map_animation> animations(map_animation_get_count());
+        animations.resize(map_animation_get_all(animations.data(), animations.size()));
+        return animations;
+    }
+
+    static std::vector<std::tuple<uint8, uint16, uint16, uint8>> GetSorted()
+    {
+        std::vector<std::tuple<uint8, uint16, uint16, uint8>> result;
+        for (const auto &animation : GetAll())
+        {
+            result.emplace_back(animation.type, animation.x, animation.y, animation.baseZ);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(MapAnimationTest, AnimationsAreGroupedByType)
+{
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 64, 64, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, 32, 32, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 32, 64, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, 96, 32, PATH_HEIGHT);
+    // Duplicates and invalid types are ignored
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 64, 64, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_COUNT, 64, 64, PATH_HEIGHT);
+
+    auto animations = GetAll();
+    ASSERT_EQ(map_animation_get_count(), 4u);
+    ASSERT_EQ(animations.size(), 4u);
+    EXPECT_EQ(animations[0].type, MAP_ANIMATION_TYPE_RIDE_ENTRANCE);
+    EXPECT_EQ(animations[0].x, 32);
+    EXPECT_EQ(animations[1].type, MAP_ANIMATION_TYPE_RIDE_ENTRANCE);
+    EXPECT_EQ(animations[1].x, 96);
+    EXPECT_EQ(animations[2].type, MAP_ANIMATION_TYPE_BANNER);
+    EXPECT_EQ(animations[2].x, 64);
+    EXPECT_EQ(animations[3].type, MAP_ANIMATION_TYPE_BANNER);
+    EXPECT_EQ(animations[3].x, 32);
+
+    // Copying fewer animations than there are keeps the same order
+    rct_map_animation firstTwo[2];
+    ASSERT_EQ(map_animation_get_all(firstTwo, 2), 2u);
+    EXPECT_EQ(firstTwo[1].x, 96);
+}
+
+TEST_F(MapAnimationTest, InvalidateRemovesFinishedAnimations)
+{
+    PlaceQueueBanner(1, 1);
+    PlaceQueueBanner(3, 1);
+    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, 32, 32, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, 64, 32, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, 96, 32, PATH_HEIGHT);
+    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, 128, 32, PATH_HEIGHT);
+
+    // Only the animations with a queue banner on their tile remain, in their previous order
+    map_animation_invalidate_all();
+    auto animations = GetAll();
+    ASSERT_EQ(animations.size(), 2u);
+    EXPECT_EQ(animations[0].x, 32);
+    EXPECT_EQ(animations[1].x, 96);
+
+    // A removed animation can be created again
+    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, 64, 32, PATH_HEIGHT);
+    EXPECT_EQ(map_animation_get_count(), 3u);
+}
+
+TEST_F(MapAnimationTest, OverflowIsRecreatedFromMap)
+{
+    // More animated elements than a saved game has room for
+    for (sint32 i = 0; i < RCT2_MAX_ANIMATED_OBJECTS + 500; i++)
+    {
+        PlaceQueueBanner(1 + i % 200, 1 + i / 200);
+    }
+    map_animation_auto_create();
+    auto expected = GetSorted();
+    ASSERT_EQ(expected.size(), (size_t)RCT2_MAX_ANIMATED_OBJECTS + 500);
+
+    // What loading a saved game does when its animations are full
+    std::vector<rct_map_animation> saved(RCT2_MAX_ANIMATED_OBJECTS);
+    ASSERT_EQ(map_animation_get_all(saved.data(), saved.size()), (size_t)RCT2_MAX_ANIMATED_OBJECTS);
+    map_animation_clear();
+    for (const auto &animation : saved)
+    {
+        map_animation_create(animation.type, animation.x, animation.y, animation.baseZ);
+    }
+    map_animation_auto_create();
+    EXPECT_EQ(GetSorted(), expected);
+}
+
+TEST_F(MapAnimationTest, RecreatingAllAnimationsKeepsOrder)
+{
+    for (sint32 i = 0; i < 300; i++)
+    {
+        PlaceQueueBanner(1 + i % 20, 1 + i / 20);
+    }
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 64, 64, PATH_HEIGHT);
+    map_animation_auto_create();
+    map_animation_invalidate_all();
+    auto before = GetAll();
+
+    // What a joining client does with the animations sent by the server
+    map_animation_clear();
+    for (const auto &animation : before)
+    {
+        map_animation_create(animation.type, animation.x, animation.y, animation.baseZ);
+    }
+    auto after = GetAll();
+    ASSERT_EQ(after.size(), before.size());
+    for (size_t i = 0; i < before.size(); i++)
+    {
+        EXPECT_EQ(after[i].type, before[i].type);
+        EXPECT_EQ(after[i].x, before[i].x);
+        EXPECT_EQ(after[i].y, before[i].y);
+        EXPECT_EQ(after[i].baseZ, before[i].baseZ);
+    }
+}
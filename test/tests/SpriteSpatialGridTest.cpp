@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/world/Sprite.h>
+#include <openrct2/world/SpriteSpatialGrid.hpp>
+
+using PeepGrid = SpriteSpatialGrid<7>;
+
+class SpriteSpatialGridTest : public testing::Test
+{
+protected:
+    std::unique_ptr<PeepGrid> _grid = std::make_unique<PeepGrid>();
+
+    std::vector<uint16> QueryRect(sint32 left, sint32 top, sint32 right, sint32 bottom) const
+    {
+        std::vector<uint16> results;
+        _grid->QueryRect(left, top, right, bottom, results);
+        return results;
+    }
+};
+
+TEST_F(SpriteSpatialGridTest, InsertMoveRemove)
+{
+    _grid->Move(5, 100, 100);
+    _grid->Move(3, 110, 120);
+    _grid->Move(9, 1000, 1000);
+    EXPECT_EQ(_grid->GetCount(), 3u);
+    EXPECT_TRUE(_grid->Contains(5));
+    EXPECT_FALSE(_grid->Contains(4));
+    EXPECT_EQ(QueryRect(0, 0, 127, 127), std::vector<uint16>({ 3, 5 }));
+
+    // Moving within a cell and into another one keeps a single entry
+    _grid->Move(5, 120, 64);
+    _grid->Move(3, 1010, 1020);
+    EXPECT_EQ(_grid->GetCount(), 3u);
+    EXPECT_EQ(QueryRect(0, 0, 127, 127), std::vector<uint16>({ 5 }));
+    EXPECT_EQ(QueryRect(1000, 1000, 1023, 1023), std::vector<uint16>({ 3, 9 }));
+
+    // Removing the first entry of a cell keeps the others
+    _grid->Remove(9);
+    EXPECT_FALSE(_grid->Contains(9));
+    EXPECT_EQ(QueryRect(1000, 1000, 1023, 1023), std::vector<uint16>({ 3 }));
+
+    // A null location removes, removing twice or out of range does nothing
+    _grid->Move(5, LOCATION_NULL, 0);
+    _grid->Remove(5);
+    _grid->Remove(MAX_SPRITES);
+    _grid->Move(MAX_SPRITES, 100, 100);
+    EXPECT_EQ(_grid->GetCount(), 1u);
+    EXPECT_TRUE(QueryRect(0, 0, 127, 127).empty());
+
+    _grid->Clear();
+    EXPECT_EQ(_grid->GetCount(), 0u);
+    EXPECT_FALSE(_grid->Contains(3));
+    EXPECT_TRUE(QueryRect(0, 0, 0x1FFF, 0x1FFF).empty());
+}
+
+TEST_F(SpriteSpatialGridTest, QueriesAcrossCellBoundaries)
+{
+    // Cells are 128 units wide, these are on both sides of the boundaries around (128, 128)
+    _grid->Move(1, 127, 127);
+    _grid->Move(2, 128, 127);
+    _grid->Move(3, 127, 128);
+    _grid->Move(4, 128, 128);
+    _grid->Move(5, 255, 255);
+    _grid->Move(6, 256, 256);
+
+    EXPECT_EQ(QueryRect(127, 127, 127, 127), std::vector<uint16>({ 1 }));
+    EXPECT_EQ(QueryRect(127, 127, 128, 127), std::vector<uint16>({ 1, 2 }));
+    EXPECT_EQ(QueryRect(128, 128, 255, 255), std::vector<uint16>({ 4, 5 }));
+
+    // Whole cells are returned, not only the sprites inside the rectangle
+    EXPECT_EQ(QueryRect(127, 127, 128, 128), std::vector<uint16>({ 1, 2, 3, 4, 5 }));
+    std::vector<uint16> results;
+    _grid->QueryRadius(200, 200, 60, results);
+    EXPECT_EQ(results, std::vector<uint16>({ 4, 5, 6 }));
+
+    // Positions and queries off the map are clamped to the edge cells
+    _grid->Move(7, -50, 10);
+    _grid->Move(8, 0x3000, 0x3000);
+    EXPECT_EQ(QueryRect(-100, 0, 10, 10), std::vector<uint16>({ 1, 7 }));
+    EXPECT_EQ(QueryRect(0x1F80, 0x1F80, 0x5000, 0x5000), std::vector<uint16>({ 8 }));
+    EXPECT_TRUE(QueryRect(-100, -100, -1, -1).empty());
+    EXPECT_TRUE(QueryRect(0x2000, 0, 0x3000, 0x1000).empty());
+}
+
+TEST_F(SpriteSpatialGridTest, MatchesScanAfterLoad)
+{
+    // Writes the sprites directly, like the importers do
+    std::mt19937 random(1234);
+    for (size_t i = 0; i < MAX_SPRITES; i++)
+    {
+        rct_sprite * sprite = get_sprite(i);
+        *sprite = {};
+        sprite->unknown.sprite_index = (uint16)i;
+        uint32 kind = random() % 4;
+        sprite->unknown.sprite_identifier = kind == 0 ? SPRITE_IDENTIFIER_NULL :
+                                            kind == 1 ? SPRITE_IDENTIFIER_LITTER : SPRITE_IDENTIFIER_PEEP;
+        sprite->unknown.x = (sint16)(random() % 0x1000);
+        sprite->unknown.y = (sint16)(random() % 0x1000);
+        if (random() % 16 == 0)
+        {
+            sprite->unknown.x = LOCATION_NULL;
+        }
+    }
+    reset_peep_spatial_index();
+
+    std::vector<uint16> results;
+    for (sint32 query = 0; query < 200; query++)
+    {
+        sint32 x = random() % 0x1000;
+        sint32 y = random() % 0x1000;
+        sint32 radius = random() % 300;
+        peep_spatial_index_query(x, y, radius, results);
+        ASSERT_TRUE(std::is_sorted(results.begin(), results.end()));
+
+        for (uint16 spriteIndex : results)
+        {
+            const rct_sprite * sprite = get_sprite(spriteIndex);
+            ASSERT_EQ(sprite->unknown.sprite_identifier, SPRITE_IDENTIFIER_PEEP);
+            ASSERT_NE(sprite->unknown.x, LOCATION_NULL);
+        }
+        for (size_t i = 0; i < MAX_SPRITES; i++)
+        {
+            const rct_sprite * sprite = get_sprite(i);
+            if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP && sprite->unknown.x != LOCATION_NULL &&
+                abs(sprite->unknown.x - x) <= radius && abs(sprite->unknown.y - y) <= radius)
+            {
+                ASSERT_TRUE(std::binary_search(results.begin(), results.end(), (uint16)i));
+            }
+        }
+    }
+}
+
+class LitterGridTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        reset_sprite_list();
+    }
+
+    static rct_litter * CreateLitter(sint32 x, sint32 y, sint32 z)
+    {
+        rct_sprite * sprite = create_sprite(1);
+        move_sprite_to_list(sprite, SPRITE_LIST_LITTER * 2);
+        sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+        sprite_move(x, y, z, sprite);
+        return &sprite->litter;
+    }
+
+    static uint16 GetDistance(const rct_litter * litter, sint32 x, sint32 y, sint32 z)
+    {
+        return abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+    }
+
+    // The litter list scans the grid queries replace
+
+    static rct_litter * ScanNearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance)
+    {
+        uint16 nearestDistance = (uint16)-1;
+        rct_litter * nearestLitter = nullptr;
+        rct_litter * litter;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
+        {
+            litter = &get_sprite(spriteIndex)->litter;
+            uint16 distance = GetDistance(litter, x, y, z);
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                nearestLitter = litter;
+            }
+        }
+        return nearestDistance <= maxDistance ? nearestLitter : nullptr;
+    }
+
+    static sint32 ScanCount(sint32 x, sint32 y, sint32 range)
+    {
+        sint32 count = 0;
+        rct_litter * litter;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
+        {
+            litter = &get_sprite(spriteIndex)->litter;
+            if (abs(litter->x - x) <= range && abs(litter->y - y) <= range)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    static void ExpectSameAsScan(sint32 x, sint32 y, sint32 z)
+    {
+        EXPECT_EQ(litter_count_in_range(x, y, 160), ScanCount(x, y, 160));
+
+        // Equally close litter on the same tile is interchangeable
+        rct_litter * expected = ScanNearest(x, y, z, 0x60);
+        rct_litter * actual = litter_get_nearest(x, y, z, 0x60);
+        ASSERT_EQ(actual == nullptr, expected == nullptr);
+        if (expected != nullptr)
+        {
+            EXPECT_EQ(GetDistance(actual, x, y, z), GetDistance(expected, x, y, z));
+            EXPECT_EQ(actual->x >> 5, expected->x >> 5);
+            EXPECT_EQ(actual->y >> 5, expected->y >> 5);
+        }
+    }
+};
+
+TEST_F(LitterGridTest, TiesOnOtherTilesFollowListOrder)
+{
+    // Both are 16 units away on different tiles. New litter is put at the head of the list, but
+    // the grid returns litter in sprite index order.
+    CreateLitter(1000, 1016, 0);
+    rct_litter * first = CreateLitter(1000, 984, 0);
+    EXPECT_EQ(litter_get_nearest(1000, 1000, 0, 0x60), first);
+    EXPECT_EQ(ScanNearest(1000, 1000, 0, 0x60), first);
+    EXPECT_EQ(litter_get_nearest(1000, 1000, 0, 15), nullptr);
+}
+
+TEST_F(LitterGridTest, MatchesLitterListScan)
+{
+    // Litter on a coarse lattice in a small area, so that there are many ties
+    std::mt19937 random(5678);
+    std::vector<rct_litter *> litter;
+    for (sint32 i = 0; i < 400; i++)
+    {
+        litter.push_back(CreateLitter(512 + (random() % 64) * 8, 512 + (random() % 64) * 8, (random() % 4) * 8));
+    }
+
+    for (sint32 round = 0; round < 3; round++)
+    {
+        for (sint32 query = 0; query < 300; query++)
+        {
+            ExpectSameAsScan(448 + random() % 640, 448 + random() % 640, (random() % 4) * 8);
+        }
+
+        // Move and remove some of the litter, the grid has to follow
+        for (sint32 i = 0; i < 50; i++)
+        {
+            rct_litter * moved = litter[random() % litter.size()];
+            sprite_move(512 + (random() % 64) * 8, 512 + (random() % 64) * 8, moved->z, (rct_sprite *)moved);
+        }
+        for (sint32 i = 0; i < 50; i++)
+        {
+            size_t index = random() % litter.size();
+            sprite_remove((rct_sprite *)litter[index]);
+            litter.erase(litter.begin() + index);
+        }
+    }
+}
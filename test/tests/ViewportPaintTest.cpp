@@ -0,0 +1,73 @@
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/Context.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/Game.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/platform/platform.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+static std::vector<uint8> PaintViewport(sint16 viewX, sint16 viewY, uint8 zoom, bool multithreading)
+{
+    constexpr sint16 WIDTH = 640;
+    constexpr sint16 HEIGHT = 480;
+
+    rct_viewport viewport = {};
+    viewport.width = WIDTH;
+    viewport.height = HEIGHT;
+    viewport.view_x = viewX;
+    viewport.view_y = viewY;
+    viewport.view_width = WIDTH << zoom;
+    viewport.view_height = HEIGHT << zoom;
+    viewport.zoom = zoom;
+
+    std::vector<uint8> bits(WIDTH * HEIGHT, 0);
+    rct_drawpixelinfo dpi = {};
+    dpi.bits = bits.data();
+    dpi.width = WIDTH;
+    dpi.height = HEIGHT;
+
+    gConfigGeneral.multithreading = multithreading;
+    viewport_paint(&viewport, &dpi, viewX, viewY, viewX + viewport.view_width, viewY + viewport.view_height);
+    return bits;
+}
+
+TEST(ViewportPaintTest, ParallelMatchesSingleThreaded)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    ParkLoadResult * plr = load_from_sv6(path.c_str());
+    ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+    ParkLoadResult_Delete(plr);
+    game_load_init();
+
+    bool multithreading = gConfigGeneral.multithreading;
+    for (uint8 zoom = 0; zoom <= 2; zoom++)
+    {
+        std::vector<uint8> expected = PaintViewport(gSavedViewX, gSavedViewY, zoom, false);
+        std::vector<uint8> actual = PaintViewport(gSavedViewX, gSavedViewY, zoom, true);
+
+        // Make sure the park was actually painted
+        std::set<uint8> colours(expected.begin(), expected.end());
+        EXPECT_GT(colours.size(), 16u);
+
+        EXPECT_TRUE(actual == expected) << "zoom " << (sint32)zoom;
+    }
+    gConfigGeneral.multithreading = multithreading;
+
+    delete context;
+}
@@ -0,0 +1,137 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/util/SawyerCoding.h>
+#include <openrct2/util/Util.h>
+
+// Measures the throughput of the sawyer chunk encoders and decoders. Run with the path of any file,
+// e.g. an uncompressed park, to use its contents, otherwise a generated buffer is used.
+
+constexpr sint32 ITERATIONS = 5;
+
+static std::vector<uint8> CreateData(size_t length)
+{
+    // Runs, repeated sequences and noise, roughly like tile elements and sprites
+    std::vector<uint8> data(length);
+    uint32 seed = 0x12345678;
+    size_t i = 0;
+    while (i < length)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t count = 1 + ((seed >> 16) % 40);
+        uint8 kind = (seed >> 8) % 4;
+        for (size_t j = 0; j < count && i < length; j++, i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            if (kind <= 1)
+            {
+                data[i] = 0;
+            }
+            else if (kind == 2 && i >= 32)
+            {
+                data[i] = data[i - 8];
+            }
+            else
+            {
+                data[i] = (uint8)(seed >> 24);
+            }
+        }
+    }
+    return data;
+}
+
+static std::vector<uint8> ReadFile(const char * path)
+{
+    std::vector<uint8> data;
+    FILE * file = fopen(path, "rb");
+    if (file != nullptr)
+    {
+        uint8 buffer[65536];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            data.insert(data.end(), buffer, buffer + read);
+        }
+        fclose(file);
+    }
+    return data;
+}
+
+template<typename TFunc>
+static void Measure(const char * name, size_t length, TFunc func)
+{
+    double best = 0;
+    for (sint32 i = 0; i < ITERATIONS; i++)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        func();
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - startTime;
+        double rate = (length / (1024.0 * 1024.0)) / duration.count();
+        if (rate > best)
+        {
+            best = rate;
+        }
+    }
+    printf("%-32s %10.1f MB/s\n", name, best);
+}
+
+static void MeasureEncoding(const char * name, const std::vector<uint8> &data, uint8 encoding)
+{
+    std::vector<uint8> encoded(data.size() * 2 + 16);
+    sawyercoding_chunk_header header;
+    header.encoding = encoding;
+    header.length = (uint32)data.size();
+
+    char label[64];
+    snprintf(label, sizeof(label), "encode %s", name);
+    size_t encodedLength = 0;
+    Measure(label, data.size(), [&]()
+    {
+        encodedLength = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header);
+    });
+
+    snprintf(label, sizeof(label), "decode %s", name);
+    Measure(label, data.size(), [&]()
+    {
+        MemoryStream ms(encoded.data(), encodedLength);
+        SawyerChunkReader reader(&ms);
+        auto chunk = reader.ReadChunk();
+        if (chunk->GetLength() != data.size() || memcmp(chunk->GetData(), data.data(), data.size()) != 0)
+        {
+            printf("%s did not decode to the original data\n", name);
+        }
+    });
+}
+
+int main(int argc, const char * * argv)
+{
+    auto data = argc > 1 ? ReadFile(argv[1]) : CreateData(3 * 1024 * 1024);
+    if (data.empty() || data.size() > 3 * 1024 * 1024)
+    {
+        printf("Input must be between 1 byte and 3 MiB.\n");
+        return 1;
+    }
+    printf("%u bytes\n", (uint32)data.size());
+
+    // Scalar kernels first, then the ones sawyercoding_init selects for this CPU
+    for (sint32 pass = 0; pass < 2; pass++)
+    {
+        if (pass == 0)
+        {
+            printf("\nscalar\n");
+        }
+        else
+        {
+            sawyercoding_init();
+            printf("\n%s\n", avx2_available() ? "AVX2" : sse41_available() ? "SSE4.1" : "scalar");
+        }
+        MeasureEncoding("none", data, CHUNK_ENCODING_NONE);
+        MeasureEncoding("rle", data, CHUNK_ENCODING_RLE);
+        MeasureEncoding("rle compressed", data, CHUNK_ENCODING_RLECOMPRESSED);
+        MeasureEncoding("rotate", data, CHUNK_ENCODING_ROTATE);
+    }
+    return 0;
+}
@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <vector>
 #include <gtest/gtest.h>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/rct12/SawyerChunkWriter.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <openrct2/util/Util.h>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -36,6 +40,65 @@ protected:
         delete[] encodedDataBuffer;
     }
 
+    // Runs, repeated sequences and noise, so every path of the encoders is taken
+    static std::vector<uint8> create_structured_data(size_t length)
+    {
+        std::vector<uint8> data(length);
+        uint32 seed = 0x12345678;
+        size_t i = 0;
+        while (i < length)
+        {
+            seed = seed * 1103515245 + 12345;
+            size_t count = std::min<size_t>(1 + ((seed >> 16) % 40), length - i);
+            uint8 kind = (seed >> 8) % 3;
+            for (size_t j = 0; j < count; j++, i++)
+            {
+                if (kind == 0)
+                {
+                    data[i] = (uint8)(seed >> 24);
+                }
+                else if (kind == 1 && i >= 32)
+                {
+                    data[i] = data[i - 1 - ((seed >> 4) % 32)];
+                }
+                else
+                {
+                    data[i] = randomdata[(i * 7 + j) % sizeof(randomdata)];
+                }
+            }
+        }
+        return data;
+    }
+
+    static void test_encode_repeat(size_t (*encode)(const uint8 *, uint8 *, size_t), const std::vector<uint8> &data)
+    {
+        std::vector<uint8> expected(data.size() * 2);
+        std::vector<uint8> actual(data.size() * 2);
+        size_t expectedLength = sawyercoding_encode_repeat_scalar(data.data(), expected.data(), data.size());
+        size_t actualLength = encode(data.data(), actual.data(), data.size());
+        ASSERT_EQ(actualLength, expectedLength);
+        ASSERT_EQ(memcmp(actual.data(), expected.data(), expectedLength), 0);
+    }
+
+    static void test_rotate(void (*rotate)(uint8 *, const uint8 *, size_t, bool))
+    {
+        for (size_t length : { 0, 1, 3, 15, 16, 17, 31, 32, 33, 100, 1024 })
+        {
+            for (bool decode : { false, true })
+            {
+                std::vector<uint8> expected(length);
+                std::vector<uint8> actual(length);
+                sawyercoding_rotate_scalar(expected.data(), randomdata, length, decode);
+                rotate(actual.data(), randomdata, length, decode);
+                ASSERT_EQ(memcmp(actual.data(), expected.data(), length), 0);
+
+                // In place, and back again
+                rotate(actual.data(), actual.data(), length, !decode);
+                ASSERT_EQ(memcmp(actual.data(), randomdata, length), 0);
+            }
+        }
+    }
+
     void test_decode(const uint8 * data, size_t size)
     {
         auto expectedLength = size - sizeof(sawyercoding_chunk_header);
@@ -72,6 +135,79 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, write_read_chunk_rle_compressed_structured)
+{
+    auto data = create_structured_data(0x40000);
+    sawyercoding_chunk_header chdr_in;
+    chdr_in.encoding = CHUNK_ENCODING_RLECOMPRESSED;
+    chdr_in.length   = (uint32)data.size();
+    std::vector<uint8> encoded(BUFFER_SIZE);
+    size_t encodedSize = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), chdr_in);
+
+    MemoryStream ms(encoded.data(), encodedSize);
+    SawyerChunkReader reader(&ms);
+    auto chunk = reader.ReadChunk();
+    ASSERT_EQ(chunk->GetLength(), data.size());
+    ASSERT_EQ(memcmp(chunk->GetData(), data.data(), data.size()), 0);
+}
+
+TEST_F(SawyerCodingTest, encode_repeat_sse4_1)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+    test_encode_repeat(sawyercoding_encode_repeat_sse4_1, std::vector<uint8>(randomdata, randomdata + sizeof(randomdata)));
+    test_encode_repeat(sawyercoding_encode_repeat_sse4_1, create_structured_data(0x40000));
+}
+
+TEST_F(SawyerCodingTest, encode_repeat_avx2)
+{
+    if (!avx2_available())
+    {
+        return;
+    }
+    test_encode_repeat(sawyercoding_encode_repeat_avx2, std::vector<uint8>(randomdata, randomdata + sizeof(randomdata)));
+    test_encode_repeat(sawyercoding_encode_repeat_avx2, create_structured_data(0x40000));
+}
+
+TEST_F(SawyerCodingTest, rotate_sse4_1)
+{
+    if (sse41_available())
+    {
+        test_rotate(sawyercoding_rotate_sse4_1);
+    }
+}
+
+TEST_F(SawyerCodingTest, rotate_avx2)
+{
+    if (avx2_available())
+    {
+        test_rotate(sawyercoding_rotate_avx2);
+    }
+}
+
+TEST_F(SawyerCodingTest, write_chunks_checksum)
+{
+    MemoryStream ms;
+    SawyerChunkWriter writer(&ms);
+    writer.WriteValue<uint32>(0x12345678);
+    writer.WriteChunk(randomdata, sizeof(randomdata), SAWYER_ENCODING::NONE);
+    writer.WriteChunk(randomdata, sizeof(randomdata), SAWYER_ENCODING::RLECOMPRESSED);
+    writer.WriteChunk(randomdata, sizeof(randomdata), SAWYER_ENCODING::ROTATE);
+
+    // The running checksum must match the one calculated over the whole stream
+    size_t length = (size_t)ms.GetLength();
+    uint32 expected = sawyercoding_calculate_checksum((const uint8 *)ms.GetData(), length);
+    ASSERT_EQ(writer.GetChecksum(), expected);
+
+    writer.WriteChecksum();
+    ASSERT_EQ(ms.GetLength(), length + sizeof(uint32));
+    uint32 written;
+    memcpy(&written, (const uint8 *)ms.GetData() + length, sizeof(written));
+    ASSERT_EQ(written, expected);
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and rountrip (encode + decode), which validates all uses.